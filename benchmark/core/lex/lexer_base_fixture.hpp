@@ -1,6 +1,8 @@
 #pragma once
 #include <benchmark/benchmark.h>
+#include <cstdio>
 #include <memory>
+#include <string>
 
 namespace docgen {
 namespace core {
@@ -12,10 +14,25 @@ struct lexer_base_fixture : benchmark::Fixture
     static constexpr const char* data_2_path = "data/data_2.txt";
     static constexpr const char* data_3_path = "data/data_3.txt";
     static constexpr const char* data_4_path = "data/data_3.txt";
+    static constexpr const char* data_5_path = "data/data_5.txt";   // keyword-dense (template-heavy header)
 
     void SetUp(const ::benchmark::State& state) 
     {}
 
+    // Reads whole file at path into a string.
+    static std::string read_file(const char* path)
+    {
+        std::unique_ptr<FILE, void (*)(FILE*)> file(fopen(path, "r"), 
+                                                    [](FILE* file) {fclose(file);});
+        std::string content;
+        char buf[4096];
+        size_t r = 0;
+        while ((r = fread(buf, 1, sizeof(buf), file.get()))) {
+            content.append(buf, r);
+        }
+        return content;
+    }
+
     void TearDown(const ::benchmark::State& state)
     {}
 };
@@ -38,6 +38,11 @@ struct lexer_fixture : lexer_base_fixture
     >;
     LexerGeneric<lex_trie_t> lexer;
     Lexer lexer_original;
+    LexerGeneric<lextable_t> lexer_table;
+    LexerGeneric<lextable_t, Status<Token<Symbol>>> lexer_table_deque;
+    DynamicLexer lexer_dynamic = DynamicLexer(
+            dynamic_lextable_t(lexeme_symbol_arr.begin(), lexeme_symbol_arr.end()));
+    ModalLexer lexer_modal = ModalLexer(make_modal_lextable());
 };
 
 BENCHMARK_F(lexer_fixture, data_1_test)(benchmark::State& st)
@@ -144,6 +149,358 @@ BENCHMARK_F(lexer_fixture, data_4_test_original)(benchmark::State& st)
     }
 }
 
+BENCHMARK_F(lexer_fixture, data_1_test_table)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        std::unique_ptr<FILE, void (*)(FILE*)> file(fopen(data_1_path, "r"), 
+                                                    [](FILE* file) {fclose(file);});
+        int c = 0;
+        while ((c = fgetc(file.get())) != EOF) {
+            lexer_table.process(c);
+        }
+        benchmark::DoNotOptimize(lexer_table.next_token()); 
+    }
+}
+
+BENCHMARK_F(lexer_fixture, data_2_test_table)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        std::unique_ptr<FILE, void (*)(FILE*)> file(fopen(data_2_path, "r"), 
+                                                    [](FILE* file) {fclose(file);});
+        int c = 0;
+        while ((c = fgetc(file.get())) != EOF) {
+            lexer_table.process(c);
+        }
+        benchmark::DoNotOptimize(lexer_table.next_token()); 
+    }
+}
+
+BENCHMARK_F(lexer_fixture, data_3_test_table)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        std::unique_ptr<FILE, void (*)(FILE*)> file(fopen(data_3_path, "r"), 
+                                                    [](FILE* file) {fclose(file);});
+        int c = 0;
+        while ((c = fgetc(file.get())) != EOF) {
+            lexer_table.process(c);
+        }
+        benchmark::DoNotOptimize(lexer_table.next_token()); 
+    }
+}
+
+BENCHMARK_F(lexer_fixture, data_4_test_table)(benchmark::State& st)
+{
+    for (auto _ : st) {
+        std::unique_ptr<FILE, void (*)(FILE*)> file(fopen(data_4_path, "r"), 
+                                                    [](FILE* file) {fclose(file);});
+        int c = 0;
+        while ((c = fgetc(file.get())) != EOF) {
+            lexer_table.process(c);
+        }
+        benchmark::DoNotOptimize(lexer_table.next_token()); 
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Throughput of per-character processing versus
+// chunked processing (which skips plain text runs at once)
+////////////////////////////////////////////////////////////
+
+template <class LexerType>
+static void process_per_char(benchmark::State& st, LexerType& lexer, const std::string& content)
+{
+    for (auto _ : st) {
+        for (char c : content) {
+            lexer.process(c);
+            while (auto token = lexer.next_token()) {
+                benchmark::DoNotOptimize(token);
+            }
+        }
+        lexer.flush();
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+template <class LexerType>
+static void process_chunk(benchmark::State& st, LexerType& lexer, const std::string& content)
+{
+    auto sink = [](auto&& token) { benchmark::DoNotOptimize(token); };
+    for (auto _ : st) {
+        lexer.process(content, sink);
+        lexer.flush(sink);
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+BENCHMARK_F(lexer_fixture, data_1_per_char)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_1_chunk)(benchmark::State& st)
+{
+    process_chunk(st, lexer_table, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_per_char)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_chunk)(benchmark::State& st)
+{
+    process_chunk(st, lexer_table, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_per_char)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table, read_file(data_3_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_chunk)(benchmark::State& st)
+{
+    process_chunk(st, lexer_table, read_file(data_3_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_4_per_char)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table, read_file(data_4_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_4_chunk)(benchmark::State& st)
+{
+    process_chunk(st, lexer_table, read_file(data_4_path));
+}
+
+////////////////////////////////////////////////////////////
+// Compile-time LexTable versus DynamicLexTable built at runtime
+// from the same lexemes
+////////////////////////////////////////////////////////////
+
+BENCHMARK_F(lexer_fixture, data_1_per_char_dynamic)(benchmark::State& st)
+{
+    process_per_char(st, lexer_dynamic, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_1_chunk_dynamic)(benchmark::State& st)
+{
+    process_chunk(st, lexer_dynamic, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_per_char_dynamic)(benchmark::State& st)
+{
+    process_per_char(st, lexer_dynamic, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_chunk_dynamic)(benchmark::State& st)
+{
+    process_chunk(st, lexer_dynamic, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_per_char_dynamic)(benchmark::State& st)
+{
+    process_per_char(st, lexer_dynamic, read_file(data_3_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_chunk_dynamic)(benchmark::State& st)
+{
+    process_chunk(st, lexer_dynamic, read_file(data_3_path));
+}
+
+////////////////////////////////////////////////////////////
+// Token queue: std::queue (std::deque) versus inline RingQueue
+// (lexer_table uses RingQueue by default)
+////////////////////////////////////////////////////////////
+
+BENCHMARK_F(lexer_fixture, data_1_queue_deque)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table_deque, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_1_queue_ring)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_queue_deque)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table_deque, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_queue_ring)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_queue_deque)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table_deque, read_file(data_3_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_queue_ring)(benchmark::State& st)
+{
+    process_per_char(st, lexer_table, read_file(data_3_path));
+}
+
+////////////////////////////////////////////////////////////
+// Whole-buffer lexing into a structure-of-arrays TokenStream
+////////////////////////////////////////////////////////////
+
+template <class LexerType>
+static void tokenize_stream(benchmark::State& st, LexerType& lexer, const std::string& content)
+{
+    for (auto _ : st) {
+        auto stream = lexer.tokenize(content);
+        benchmark::DoNotOptimize(stream.symbols().data());
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+BENCHMARK_F(lexer_fixture, data_1_stream)(benchmark::State& st)
+{
+    tokenize_stream(st, lexer_table, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_stream)(benchmark::State& st)
+{
+    tokenize_stream(st, lexer_table, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_stream)(benchmark::State& st)
+{
+    tokenize_stream(st, lexer_table, read_file(data_3_path));
+}
+
+////////////////////////////////////////////////////////////
+// Skipping every brace-delimited block (as requested by the parser
+// for function bodies) versus lexing it
+////////////////////////////////////////////////////////////
+
+template <class LexerType>
+static void process_skip(benchmark::State& st, LexerType& lexer,
+                         const std::string& content, bool skip)
+{
+    auto sink = [&](auto&& token) {
+        benchmark::DoNotOptimize(token);
+        if (skip && token.name == Symbol::OPEN_BRACE) {
+            lexer.skip_block();
+        }
+    };
+    for (auto _ : st) {
+        lexer.process(content, sink);
+        lexer.flush(sink);
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+BENCHMARK_F(lexer_fixture, data_1_noskip)(benchmark::State& st)
+{
+    process_skip(st, lexer_modal, read_file(data_1_path), false);
+}
+
+BENCHMARK_F(lexer_fixture, data_1_skip)(benchmark::State& st)
+{
+    process_skip(st, lexer_modal, read_file(data_1_path), true);
+}
+
+BENCHMARK_F(lexer_fixture, data_2_noskip)(benchmark::State& st)
+{
+    process_skip(st, lexer_modal, read_file(data_2_path), false);
+}
+
+BENCHMARK_F(lexer_fixture, data_2_skip)(benchmark::State& st)
+{
+    process_skip(st, lexer_modal, read_file(data_2_path), true);
+}
+
+BENCHMARK_F(lexer_fixture, data_3_noskip)(benchmark::State& st)
+{
+    process_skip(st, lexer_modal, read_file(data_3_path), false);
+}
+
+BENCHMARK_F(lexer_fixture, data_3_skip)(benchmark::State& st)
+{
+    process_skip(st, lexer_modal, read_file(data_3_path), true);
+}
+
+////////////////////////////////////////////////////////////
+// Runs of WHITESPACE and NEWLINE resolved as one token each
+////////////////////////////////////////////////////////////
+
+BENCHMARK_F(lexer_fixture, data_1_coalesce)(benchmark::State& st)
+{
+    lexer_table.coalesce(true);
+    process_chunk(st, lexer_table, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_2_coalesce)(benchmark::State& st)
+{
+    lexer_table.coalesce(true);
+    process_chunk(st, lexer_table, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_fixture, data_3_coalesce)(benchmark::State& st)
+{
+    lexer_table.coalesce(true);
+    process_chunk(st, lexer_table, read_file(data_3_path));
+}
+
+////////////////////////////////////////////////////////////
+// Worst-case inputs made of near-miss prefixes.
+// Time per byte must stay flat as input grows (reported complexity O(N)).
+////////////////////////////////////////////////////////////
+
+static std::string repeat(const char* pattern, size_t n)
+{
+    std::string content;
+    while (content.size() < n) {
+        content += pattern;
+    }
+    content.resize(n);
+    return content;
+}
+
+template <class LexerType>
+static void process_adversarial(benchmark::State& st, LexerType& lexer, const char* pattern)
+{
+    const std::string content = repeat(pattern, st.range(0));
+    auto sink = [](auto&& token) { benchmark::DoNotOptimize(token); };
+    for (auto _ : st) {
+        lexer.process(content, sink);
+        lexer.flush(sink);
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+    st.SetComplexityN(st.range(0));
+}
+
+BENCHMARK_DEFINE_F(lexer_fixture, adversarial_slash)(benchmark::State& st)
+{
+    process_adversarial(st, lexer_table, "/");
+}
+BENCHMARK_REGISTER_F(lexer_fixture, adversarial_slash)
+    ->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
+BENCHMARK_DEFINE_F(lexer_fixture, adversarial_star)(benchmark::State& st)
+{
+    process_adversarial(st, lexer_table, "*");
+}
+BENCHMARK_REGISTER_F(lexer_fixture, adversarial_star)
+    ->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
+BENCHMARK_DEFINE_F(lexer_fixture, adversarial_para)(benchmark::State& st)
+{
+    process_adversarial(st, lexer_table, "@para");
+}
+BENCHMARK_REGISTER_F(lexer_fixture, adversarial_para)
+    ->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
+BENCHMARK_DEFINE_F(lexer_fixture, adversarial_block)(benchmark::State& st)
+{
+    process_adversarial(st, lexer_table, "/*/*!*");
+}
+BENCHMARK_REGISTER_F(lexer_fixture, adversarial_block)
+    ->RangeMultiplier(4)->Range(1 << 10, 1 << 20)->Complexity(benchmark::oN);
+
 } // namespace lex
 } // namespace core
 } // namespace docgen
@@ -8,6 +8,7 @@ namespace lex {
 struct lexer_legacy_2_fixture : lexer_base_fixture
 {
     Lexer lexer;
+    BasicLexer<Status<Token<Symbol>, RingQueue<Token<Symbol>>>> lexer_ring;
 };
 
 BENCHMARK_F(lexer_legacy_2_fixture, data_1_test)(benchmark::State& st)
@@ -62,6 +63,56 @@ BENCHMARK_F(lexer_legacy_2_fixture, data_4_test)(benchmark::State& st)
     }
 }
 
+////////////////////////////////////////////////////////////
+// Token queue: std::queue (std::deque) versus inline RingQueue.
+// Tokens are drained after every char as a parser would.
+////////////////////////////////////////////////////////////
+
+template <class LexerType>
+static void process_drain(benchmark::State& st, LexerType& lexer, const std::string& content)
+{
+    for (auto _ : st) {
+        for (char c : content) {
+            lexer.process(c);
+            while (auto token = lexer.next_token()) {
+                benchmark::DoNotOptimize(token);
+            }
+        }
+        lexer.flush();
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+BENCHMARK_F(lexer_legacy_2_fixture, data_1_queue_deque)(benchmark::State& st)
+{
+    process_drain(st, lexer, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_legacy_2_fixture, data_1_queue_ring)(benchmark::State& st)
+{
+    process_drain(st, lexer_ring, read_file(data_1_path));
+}
+
+BENCHMARK_F(lexer_legacy_2_fixture, data_2_queue_deque)(benchmark::State& st)
+{
+    process_drain(st, lexer, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_legacy_2_fixture, data_2_queue_ring)(benchmark::State& st)
+{
+    process_drain(st, lexer_ring, read_file(data_2_path));
+}
+
+BENCHMARK_F(lexer_legacy_2_fixture, data_3_queue_deque)(benchmark::State& st)
+{
+    process_drain(st, lexer, read_file(data_3_path));
+}
+
+BENCHMARK_F(lexer_legacy_2_fixture, data_3_queue_ring)(benchmark::State& st)
+{
+    process_drain(st, lexer_ring, read_file(data_3_path));
+}
+
 } // namespace lex
 } // namespace core
 } // namespace docgen
@@ -0,0 +1,167 @@
+#include <core/lex/legacy/lexer.hpp>
+#include <core/lex/lexer.hpp>
+#include <core/lex/aho_corasick.hpp>
+#include "lexer_base_fixture.hpp"
+
+////////////////////////////////////////////////////////////
+// Lexer shootout
+//
+// Every lexer engine over the same corpora, reported in bytes/sec.
+// Each engine is fed the whole file from memory through its fastest
+// public input path and every token is consumed.
+// legacy_2 is registered from lexer_shootout_legacy_2.cpp,
+// since its Lexer cannot be declared in the same translation unit.
+////////////////////////////////////////////////////////////
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+using base_t = lexer_base_fixture;
+
+// legacy: reads from a FILE* (opened on memory here to exclude disk I/O)
+static void shootout_legacy(benchmark::State& st, const char* path)
+{
+    std::string content = base_t::read_file(path);
+    for (auto _ : st) {
+        FILE* file = fmemopen(content.data(), content.size(), "r");
+        core::Lexer lexer(file);
+        lexer.process();
+        benchmark::DoNotOptimize(lexer.get_tokens().data());
+        fclose(file);
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+// chunked processing with every token moved into a sink
+template <class LexerType>
+static void shootout_chunk(benchmark::State& st, LexerType lexer, const char* path)
+{
+    const std::string content = base_t::read_file(path);
+    auto sink = [](auto&& token) { benchmark::DoNotOptimize(token); };
+    for (auto _ : st) {
+        lexer.process(content, sink);
+        lexer.flush(sink);
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+// whole-buffer tokenizing with every token view passed to a sink
+template <class LexerType>
+static void shootout_tokenize(benchmark::State& st, LexerType lexer, const char* path)
+{
+    const std::string content = base_t::read_file(path);
+    auto sink = [](auto&& token) { benchmark::DoNotOptimize(token); };
+    for (auto _ : st) {
+        lexer.tokenize(content, sink);
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+static void shootout_lextrie(benchmark::State& st, const char* path)
+{
+    shootout_chunk(st, Lexer(), path);
+}
+
+static void shootout_lextable(benchmark::State& st, const char* path)
+{
+    shootout_chunk(st, LexerGeneric<lextable_t>(), path);
+}
+
+static void shootout_lextable_tokenize(benchmark::State& st, const char* path)
+{
+    shootout_tokenize(st, LexerGeneric<lextable_t>(), path);
+}
+
+static void shootout_dynamic(benchmark::State& st, const char* path)
+{
+    shootout_chunk(st, DynamicLexer(
+                dynamic_lextable_t(lexeme_symbol_arr.begin(), lexeme_symbol_arr.end())), path);
+}
+
+static void shootout_modal(benchmark::State& st, const char* path)
+{
+    shootout_chunk(st, ModalLexer(), path);
+}
+
+static void shootout_dynamic_tokenize(benchmark::State& st, const char* path)
+{
+    shootout_tokenize(st, DynamicLexer(make_dynamic_lextable()), path);
+}
+
+// lexemes matched with 8-byte loads (see SwarMatcher)
+static void shootout_dynamic_swar_tokenize(benchmark::State& st, const char* path)
+{
+    DynamicLexer lexer(make_dynamic_lextable());
+    lexer.use_swar(true);
+    shootout_tokenize(st, lexer, path);
+}
+
+static void shootout_modal_tokenize(benchmark::State& st, const char* path)
+{
+    shootout_tokenize(st, ModalLexer(), path);
+}
+
+static void shootout_aho_corasick(benchmark::State& st, const char* path)
+{
+    shootout_chunk(st, AhoCorasickLexer<Symbol>(
+                aho_corasick_table_t(lexeme_symbol_arr.begin(), lexeme_symbol_arr.end())), path);
+}
+
+static void shootout_aho_corasick_tokenize(benchmark::State& st, const char* path)
+{
+    shootout_tokenize(st, AhoCorasickLexer<Symbol>(
+                aho_corasick_table_t(lexeme_symbol_arr.begin(), lexeme_symbol_arr.end())), path);
+}
+
+BENCHMARK_CAPTURE(shootout_legacy, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_legacy, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_legacy, data_3, base_t::data_3_path);
+
+BENCHMARK_CAPTURE(shootout_lextrie, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_lextrie, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_lextrie, data_3, base_t::data_3_path);
+
+BENCHMARK_CAPTURE(shootout_lextable, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_lextable, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_lextable, data_3, base_t::data_3_path);
+
+BENCHMARK_CAPTURE(shootout_lextable_tokenize, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_lextable_tokenize, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_lextable_tokenize, data_3, base_t::data_3_path);
+BENCHMARK_CAPTURE(shootout_lextable_tokenize, data_5, base_t::data_5_path);
+
+BENCHMARK_CAPTURE(shootout_dynamic, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_dynamic, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_dynamic, data_3, base_t::data_3_path);
+
+BENCHMARK_CAPTURE(shootout_dynamic_tokenize, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_dynamic_tokenize, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_dynamic_tokenize, data_3, base_t::data_3_path);
+BENCHMARK_CAPTURE(shootout_dynamic_tokenize, data_5, base_t::data_5_path);
+
+BENCHMARK_CAPTURE(shootout_dynamic_swar_tokenize, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_dynamic_swar_tokenize, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_dynamic_swar_tokenize, data_3, base_t::data_3_path);
+BENCHMARK_CAPTURE(shootout_dynamic_swar_tokenize, data_5, base_t::data_5_path);
+
+BENCHMARK_CAPTURE(shootout_modal, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_modal, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_modal, data_3, base_t::data_3_path);
+
+BENCHMARK_CAPTURE(shootout_modal_tokenize, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_modal_tokenize, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_modal_tokenize, data_3, base_t::data_3_path);
+BENCHMARK_CAPTURE(shootout_modal_tokenize, data_5, base_t::data_5_path);
+
+BENCHMARK_CAPTURE(shootout_aho_corasick, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_aho_corasick, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_aho_corasick, data_3, base_t::data_3_path);
+
+BENCHMARK_CAPTURE(shootout_aho_corasick_tokenize, data_1, base_t::data_1_path);
+BENCHMARK_CAPTURE(shootout_aho_corasick_tokenize, data_2, base_t::data_2_path);
+BENCHMARK_CAPTURE(shootout_aho_corasick_tokenize, data_3, base_t::data_3_path);
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
@@ -0,0 +1,38 @@
+#include <core/lex/legacy_2/lexer.hpp>
+#include "lexer_base_fixture.hpp"
+
+////////////////////////////////////////////////////////////
+// legacy_2 part of the lexer shootout (see lexer_shootout_benchmark.cpp).
+// legacy_2 only processes one char at a time.
+////////////////////////////////////////////////////////////
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+static void shootout_legacy_2(benchmark::State& st, const char* path)
+{
+    const std::string content = lexer_base_fixture::read_file(path);
+    Lexer lexer;
+    for (auto _ : st) {
+        for (char c : content) {
+            lexer.process(c);
+            while (auto token = lexer.next_token()) {
+                benchmark::DoNotOptimize(token);
+            }
+        }
+        lexer.flush();
+        while (auto token = lexer.next_token()) {
+            benchmark::DoNotOptimize(token);
+        }
+    }
+    st.SetBytesProcessed(st.iterations() * content.size());
+}
+
+BENCHMARK_CAPTURE(shootout_legacy_2, data_1, lexer_base_fixture::data_1_path);
+BENCHMARK_CAPTURE(shootout_legacy_2, data_2, lexer_base_fixture::data_2_path);
+BENCHMARK_CAPTURE(shootout_legacy_2, data_3, lexer_base_fixture::data_3_path);
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
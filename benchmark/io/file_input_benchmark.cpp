@@ -0,0 +1,177 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <benchmark/benchmark.h>
+#include <core/lex/lexer.hpp>
+#include <io/mapped_file.hpp>
+#include <session.hpp>
+
+////////////////////////////////////////////////////////////
+// File input
+//
+// Reading a file through 4 KiB fread chunks (as parse_file used to)
+// against reading it whole with MappedFile, each lexed along the way
+// as parse_file does, on a warm and on a cold page cache.
+// The page cache is dropped for the file before every cold iteration
+// (posix_fadvise DONTNEED, which needs no privileges but leaves
+// pages still mapped by another process in place).
+// Cold benchmarks are skipped where there is no posix_fadvise (e.g. macOS).
+////////////////////////////////////////////////////////////
+
+namespace docgen {
+namespace io {
+
+static constexpr const char* data_1_path = "data/data_1.txt";          // read (below MAP_MIN_SIZE)
+static constexpr const char* data_3_path = "data/data_3.txt";          // mapped
+static constexpr const char* data_large_path = "data/data_large.txt";  // written by prepare()
+
+static constexpr size_t LARGE_SIZE = 4 << 20;
+
+// Writes data_large (about LARGE_SIZE bytes made of copies of data_3) if path is it
+// and it is not there yet.
+static void prepare(const char* path)
+{
+    if (path != data_large_path || std::ifstream(path).good()) {
+        return;
+    }
+    std::ifstream in(data_3_path);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream out(path);
+    for (size_t n = 0; n < LARGE_SIZE; n += content.size()) {
+        out << content;
+    }
+}
+
+static size_t file_size(const char* path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in.tellg();
+}
+
+#ifdef POSIX_FADV_DONTNEED
+static constexpr bool can_drop_cache = true;
+#else
+static constexpr bool can_drop_cache = false;   // e.g. macOS
+#endif
+
+static void drop_cache(const char* path)
+{
+#ifdef POSIX_FADV_DONTNEED
+    int fd = open(path, O_RDONLY);
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+#else
+    static_cast<void>(path);
+#endif
+}
+
+// Skips a cold benchmark where the page cache cannot be dropped.
+// Returns true if skipped.
+static bool skip_cold(benchmark::State& st, bool cold)
+{
+    if (cold && !can_drop_cache) {
+        st.SkipWithError("cannot drop the page cache on this platform");
+        return true;
+    }
+    return false;
+}
+
+static core::lex::ModalLexer make_lexer()
+{
+    core::lex::ModalLexer lexer(core::lex::make_modal_lextable());
+    lexer.coalesce(true);
+    return lexer;
+}
+
+static void input_fread(benchmark::State& st, const char* path, bool cold)
+{
+    core::lex::ModalLexer lexer = make_lexer();
+    auto sink = [](auto&& token) { benchmark::DoNotOptimize(token); };
+    prepare(path);
+    if (skip_cold(st, cold)) {
+        return;
+    }
+    for (auto _ : st) {
+        if (cold) {
+            st.PauseTiming();
+            drop_cache(path);
+            st.ResumeTiming();
+        }
+        FILE* file = fopen(path, "r");
+        char buf[4096];
+        size_t r;
+        while ((r = fread(buf, 1, sizeof(buf), file))) {
+            lexer.process(std::string_view(buf, r), sink);
+        }
+        fclose(file);
+        lexer.flush(sink);
+    }
+    st.SetBytesProcessed(st.iterations() * file_size(path));
+}
+
+static void input_mapped(benchmark::State& st, const char* path, bool cold)
+{
+    core::lex::ModalLexer lexer = make_lexer();
+    auto sink = [](auto&& token) { benchmark::DoNotOptimize(token); };
+    prepare(path);
+    if (skip_cold(st, cold)) {
+        return;
+    }
+    for (auto _ : st) {
+        if (cold) {
+            st.PauseTiming();
+            drop_cache(path);
+            st.ResumeTiming();
+        }
+        MappedFile file(path);
+        lexer.process(file.view(), sink);
+        lexer.flush(sink);
+    }
+    st.SetBytesProcessed(st.iterations() * file_size(path));
+}
+
+// whole of Session::parse_file (input, lexing and parsing)
+static void input_parse_file(benchmark::State& st, const char* path, bool cold)
+{
+    Session session;
+    prepare(path);
+    if (skip_cold(st, cold)) {
+        return;
+    }
+    for (auto _ : st) {
+        if (cold) {
+            st.PauseTiming();
+            drop_cache(path);
+            st.ResumeTiming();
+        }
+        nlohmann::json parsed;
+        session.parse_file(path, parsed);
+        benchmark::DoNotOptimize(parsed);
+    }
+    st.SetBytesProcessed(st.iterations() * file_size(path));
+}
+
+BENCHMARK_CAPTURE(input_fread, data_1_warm, data_1_path, false);
+BENCHMARK_CAPTURE(input_fread, data_3_warm, data_3_path, false);
+BENCHMARK_CAPTURE(input_fread, data_large_warm, data_large_path, false);
+BENCHMARK_CAPTURE(input_fread, data_1_cold, data_1_path, true);
+BENCHMARK_CAPTURE(input_fread, data_3_cold, data_3_path, true);
+BENCHMARK_CAPTURE(input_fread, data_large_cold, data_large_path, true);
+
+BENCHMARK_CAPTURE(input_mapped, data_1_warm, data_1_path, false);
+BENCHMARK_CAPTURE(input_mapped, data_3_warm, data_3_path, false);
+BENCHMARK_CAPTURE(input_mapped, data_large_warm, data_large_path, false);
+BENCHMARK_CAPTURE(input_mapped, data_1_cold, data_1_path, true);
+BENCHMARK_CAPTURE(input_mapped, data_3_cold, data_3_path, true);
+BENCHMARK_CAPTURE(input_mapped, data_large_cold, data_large_path, true);
+
+BENCHMARK_CAPTURE(input_parse_file, data_3_warm, data_3_path, false);
+BENCHMARK_CAPTURE(input_parse_file, data_large_warm, data_large_path, false);
+BENCHMARK_CAPTURE(input_parse_file, data_large_cold, data_large_path, true);
+
+} // namespace io
+} // namespace docgen
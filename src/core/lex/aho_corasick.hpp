@@ -0,0 +1,561 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <core/lex/byte_scanner.hpp>
+#include <core/lex/status.hpp>
+#include <core/lex/token_stream.hpp>
+#include <core/symbol.hpp>
+#include <core/token.hpp>
+#include <exceptions/exceptions.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+////////////////////////////////////////////////////////////
+// AhoCorasickTable
+//
+// Aho-Corasick automaton over a list of (string, symbol) pairs.
+// The goto function and failure links are folded into
+// a complete (state x byte) transition table at construction,
+// so every input byte costs exactly one table lookup.
+// Each state also stores its depth (length of the longest suffix of input
+// that is a prefix of some lexeme) and the longest lexeme
+// that is a suffix of input (found by following failure links).
+//
+// Like DynamicLexTable, the built automaton is immutable
+// and shared between copies.
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+struct AhoCorasickTable
+{
+    using symbol_t = SymbolType;
+    using state_t = uint16_t;
+    using pair_t = std::pair<std::string_view, symbol_t>;
+
+    static constexpr size_t max_states = std::numeric_limits<state_t>::max() + size_t(1);
+
+    // Constructs automaton from a list of pairs of string and symbol.
+    // Strings must be non-empty (std::invalid_argument otherwise).
+    // If a string appears more than once, the last symbol associated
+    // with it is used.
+    AhoCorasickTable(std::initializer_list<pair_t> pairs);
+
+    // Same as above for any range of pairs whose first element
+    // is convertible to std::string_view.
+    template <class Iter>
+    AhoCorasickTable(Iter first, Iter last);
+
+    // Returns state reached from state on c.
+    state_t next(state_t state, char c) const;
+
+    // Returns length of longest suffix of input that is a prefix of some lexeme.
+    size_t depth(state_t state) const;
+
+    // Returns length of longest lexeme that is a suffix of input (0 if none).
+    size_t match_length(state_t state) const;
+
+    // Returns symbol of longest lexeme that is a suffix of input.
+    // Only meaningful if match_length(state) is non-zero.
+    symbol_t match_symbol(state_t state) const;
+
+    // Returns the set of chars that start some lexeme.
+    byte_set_t lead_bytes() const;
+
+    size_t n_states() const;
+
+private:
+
+    struct data_t
+    {
+        std::vector<state_t> next;              // next[state * 256 + byte]
+        std::vector<uint8_t> depth;             // depth of every state in the trie
+        std::vector<uint8_t> match_length;      // longest lexeme that is a suffix
+        std::vector<symbol_t> match_symbol;     // symbol of that lexeme
+    };
+
+    static data_t build(std::vector<std::pair<std::string, symbol_t>>&& pairs);
+
+    std::shared_ptr<const data_t> data_;
+};
+
+////////////////////////////////////////////////////////////
+// AhoCorasickLexer
+//
+// Lexer with the same interface as LexerGeneric that runs an AhoCorasickTable
+// over input once and resolves lexeme occurrences to leftmost-longest tokens.
+//
+// The earliest occurrence seen so far is held as a candidate.
+// It is final once no lexeme that is still in progress
+// (i.e. within depth of the current state) starts at or before it.
+// Only the chars after a final candidate are walked again,
+// which are never more than the longest lexeme.
+//
+// Leftmost-longest matching differs from the greedy trie walk of LexerGeneric
+// only when a lexeme starts inside a failed partial match:
+// e.g. with "@sdesc" and "struct", "@struct" is TEXT("@") STRUCT here,
+// but a single TEXT("@struct") for LexerGeneric.
+////////////////////////////////////////////////////////////
+
+template <class SymbolType
+        , class StatusType = Status<Token<SymbolType>, RingQueue<Token<SymbolType>>>
+        >
+struct AhoCorasickLexer
+{
+    using table_t = AhoCorasickTable<SymbolType>;
+    using symbol_t = SymbolType;
+    using status_t = StatusType;
+    using token_t = typename status_t::token_t;
+    using token_view_t = TokenView<symbol_t>;
+    using token_stream_t = TokenStream<symbol_t>;
+
+    explicit AhoCorasickLexer(table_t table);
+
+    void process(char c);
+    void flush();
+    std::optional<token_t> next_token();
+
+    // See LexerGeneric.
+    void process(std::string_view chunk);
+    template <class Sink>
+    void process(std::string_view chunk, Sink&& sink);
+    template <class Sink>
+    void flush(Sink&& sink);
+    template <class Sink>
+    void tokenize(std::string_view source, Sink&& sink);
+    token_stream_t tokenize(std::string_view source);
+
+private:
+    using state_t = typename table_t::state_t;
+
+    template <class Sink>
+    void drain(Sink& sink);
+
+    const char* skip_text(const char* first, const char* last);
+
+    // Runs automaton over every char of buf_ starting at pos_,
+    // emitting candidates as soon as they are final.
+    void resume();
+
+    // Tokenizes text_, everything in buf_ before the candidate and the candidate.
+    // Drops everything up to the end of the candidate from buf_ and resets the automaton.
+    void tokenize_candidate();
+
+    void tokenize_text();
+    void reset();
+
+    table_t table_;
+    std::string text_;
+    std::string buf_;           // chars that may still be part of a lexeme
+    size_t pos_ = 0;            // number of chars of buf_ run through automaton
+    state_t state_ = 0;
+    bool has_cand_ = false;     // whether a candidate is held
+    size_t cand_begin_ = 0;     // candidate is buf_[cand_begin_, cand_end_)
+    size_t cand_end_ = 0;
+    symbol_t cand_symbol_ = {};
+    status_t status_;
+    ByteScanner scanner_ = ByteScanner(table_.lead_bytes());
+};
+
+////////////////////////////////////////////////////////////
+// AhoCorasickTable Implementation
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+inline AhoCorasickTable<SymbolType>::AhoCorasickTable(std::initializer_list<pair_t> pairs)
+    : AhoCorasickTable(pairs.begin(), pairs.end())
+{}
+
+template <class SymbolType>
+template <class Iter>
+inline AhoCorasickTable<SymbolType>::AhoCorasickTable(Iter first, Iter last)
+{
+    std::vector<std::pair<std::string, symbol_t>> pairs;
+    for (; first != last; ++first) {
+        pairs.emplace_back(std::string(std::string_view(first->first)), first->second);
+    }
+    data_ = std::make_shared<const data_t>(build(std::move(pairs)));
+}
+
+template <class SymbolType>
+inline typename AhoCorasickTable<SymbolType>::data_t
+AhoCorasickTable<SymbolType>::build(std::vector<std::pair<std::string, symbol_t>>&& pairs)
+{
+    data_t data;
+    std::vector<state_t> go(256, 0);            // trie transitions only
+    std::vector<bool> accept(1, false);
+    data.depth.push_back(0);
+    data.match_symbol.emplace_back();
+
+    // build trie
+    for (const auto& [str, sym] : pairs) {
+        if (str.empty()) {
+            throw std::invalid_argument("lexer table strings must be non-empty");
+        }
+        if (str.size() > std::numeric_limits<uint8_t>::max()) {
+            throw exceptions::exception("lexeme is too long for a lexer table");
+        }
+        size_t state = 0;
+        for (char c : str) {
+            const size_t idx = state * 256 + static_cast<unsigned char>(c);
+            if (!go[idx]) {
+                const size_t child = accept.size();
+                if (child >= max_states) {
+                    throw exceptions::exception("too many lexemes for a lexer table");
+                }
+                go[idx] = static_cast<state_t>(child);
+                go.resize(go.size() + 256, 0);
+                accept.push_back(false);
+                data.depth.push_back(data.depth[state] + 1);
+                data.match_symbol.emplace_back();
+            }
+            state = go[idx];
+        }
+        accept[state] = true;
+        data.match_symbol[state] = sym;
+    }
+
+    // fold failure links into complete transitions in breadth-first order,
+    // so that the failure state of every state is complete before it is needed
+    const size_t n = accept.size();
+    data.next.assign(n * 256, 0);
+    data.match_length.assign(n, 0);
+    std::vector<state_t> fail(n, 0);
+    std::deque<state_t> queue;
+
+    for (size_t c = 0; c < 256; ++c) {
+        const state_t child = go[c];
+        data.next[c] = child;
+        if (child) {
+            queue.push_back(child);
+        }
+    }
+
+    while (!queue.empty()) {
+        const state_t state = queue.front();
+        queue.pop_front();
+
+        // longest lexeme that is a suffix
+        if (accept[state]) {
+            data.match_length[state] = data.depth[state];
+        } else {
+            data.match_length[state] = data.match_length[fail[state]];
+            data.match_symbol[state] = data.match_symbol[fail[state]];
+        }
+
+        for (size_t c = 0; c < 256; ++c) {
+            const state_t child = go[state * 256 + c];
+            const state_t fallback = data.next[fail[state] * 256 + c];
+            if (child) {
+                fail[child] = fallback;
+                data.next[state * 256 + c] = child;
+                queue.push_back(child);
+            } else {
+                data.next[state * 256 + c] = fallback;
+            }
+        }
+    }
+
+    return data;
+}
+
+template <class SymbolType>
+inline typename AhoCorasickTable<SymbolType>::state_t
+AhoCorasickTable<SymbolType>::next(state_t state, char c) const
+{
+    return data_->next[state * 256 + static_cast<unsigned char>(c)];
+}
+
+template <class SymbolType>
+inline size_t AhoCorasickTable<SymbolType>::depth(state_t state) const
+{
+    return data_->depth[state];
+}
+
+template <class SymbolType>
+inline size_t AhoCorasickTable<SymbolType>::match_length(state_t state) const
+{
+    return data_->match_length[state];
+}
+
+template <class SymbolType>
+inline typename AhoCorasickTable<SymbolType>::symbol_t
+AhoCorasickTable<SymbolType>::match_symbol(state_t state) const
+{
+    return data_->match_symbol[state];
+}
+
+template <class SymbolType>
+inline byte_set_t AhoCorasickTable<SymbolType>::lead_bytes() const
+{
+    byte_set_t set = {};
+    for (size_t c = 0; c < set.size(); ++c) {
+        set[c] = (data_->next[c] != 0);
+    }
+    return set;
+}
+
+template <class SymbolType>
+inline size_t AhoCorasickTable<SymbolType>::n_states() const
+{
+    return data_->depth.size();
+}
+
+////////////////////////////////////////////////////////////
+// AhoCorasickLexer Implementation
+////////////////////////////////////////////////////////////
+
+template <class SymbolType, class StatusType>
+inline AhoCorasickLexer<SymbolType, StatusType>::AhoCorasickLexer(table_t table)
+    : table_(std::move(table))
+{}
+
+template <class SymbolType, class StatusType>
+inline void AhoCorasickLexer<SymbolType, StatusType>::tokenize_text()
+{
+    if (!text_.empty()) {
+        status_.tokens.emplace(symbol_t::TEXT, std::move(text_));
+    }
+}
+
+template <class SymbolType, class StatusType>
+inline std::optional<typename AhoCorasickLexer<SymbolType, StatusType>::token_t>
+AhoCorasickLexer<SymbolType, StatusType>::next_token()
+{
+    if (!status_.tokens.empty()) {
+        token_t token = std::move(status_.tokens.front());
+        status_.tokens.pop();
+        return token;
+    }
+    return {};
+}
+
+template <class SymbolType, class StatusType>
+inline void AhoCorasickLexer<SymbolType, StatusType>::reset()
+{
+    text_.clear();
+    buf_.clear();
+    pos_ = 0;
+    state_ = 0;
+    has_cand_ = false;
+}
+
+template <class SymbolType, class StatusType>
+inline void AhoCorasickLexer<SymbolType, StatusType>::process(char c)
+{
+    // usual case: c is plain text and nothing is in progress
+    if (buf_.empty() && !table_.next(0, c)) {
+        text_.push_back(c);
+        return;
+    }
+    buf_.push_back(c);
+    this->resume();
+}
+
+template <class SymbolType, class StatusType>
+inline void AhoCorasickLexer<SymbolType, StatusType>::tokenize_candidate()
+{
+    text_.append(buf_, 0, cand_begin_);
+    this->tokenize_text();
+    if (keeps_lexeme(cand_symbol_)) {
+        status_.tokens.emplace(cand_symbol_, buf_.substr(cand_begin_, cand_end_ - cand_begin_));
+    } else {
+        status_.tokens.emplace(cand_symbol_);
+    }
+    buf_.erase(0, cand_end_);
+    pos_ = 0;
+    state_ = 0;
+    has_cand_ = false;
+}
+
+template <class SymbolType, class StatusType>
+inline void AhoCorasickLexer<SymbolType, StatusType>::resume()
+{
+    while (pos_ < buf_.size()) {
+        state_ = table_.next(state_, buf_[pos_++]);
+
+        // longest lexeme ending here starts earliest among those ending here
+        if (const size_t len = table_.match_length(state_)) {
+            const size_t begin = pos_ - len;
+            if (!has_cand_ || begin <= cand_begin_) {
+                has_cand_ = true;
+                cand_begin_ = begin;
+                cand_end_ = pos_;
+                cand_symbol_ = table_.match_symbol(state_);
+            }
+        }
+
+        // every lexeme still in progress starts at or after live
+        const size_t live = pos_ - table_.depth(state_);
+
+        if (has_cand_) {
+            if (live > cand_begin_) {
+                this->tokenize_candidate();
+            }
+            continue;
+        }
+
+        // chars before live can never be part of a lexeme
+        if (live) {
+            text_.append(buf_, 0, live);
+            buf_.erase(0, live);
+            pos_ -= live;
+        }
+    }
+}
+
+template <class SymbolType, class StatusType>
+inline void AhoCorasickLexer<SymbolType, StatusType>::flush()
+{
+    // no more input: candidate is final
+    while (has_cand_) {
+        this->tokenize_candidate();
+        this->resume();
+    }
+    text_.append(buf_);
+    this->tokenize_text();
+    this->reset();
+}
+
+template <class SymbolType, class StatusType>
+template <class Sink>
+inline void AhoCorasickLexer<SymbolType, StatusType>::drain(Sink& sink)
+{
+    while (!status_.tokens.empty()) {
+        sink(std::move(status_.tokens.front()));
+        status_.tokens.pop();
+    }
+}
+
+template <class SymbolType, class StatusType>
+inline const char* AhoCorasickLexer<SymbolType, StatusType>::skip_text(const char* first, const char* last)
+{
+    if (!buf_.empty()) {
+        return first;
+    }
+    const char* next = scanner_.find(first, last);
+    text_.append(first, next);
+    return next;
+}
+
+template <class SymbolType, class StatusType>
+inline void AhoCorasickLexer<SymbolType, StatusType>::process(std::string_view chunk)
+{
+    const char* it = chunk.data();
+    const char* const end = it + chunk.size();
+    while ((it = this->skip_text(it, end)) != end) {
+        this->process(*it++);
+    }
+}
+
+template <class SymbolType, class StatusType>
+template <class Sink>
+inline void AhoCorasickLexer<SymbolType, StatusType>::process(std::string_view chunk, Sink&& sink)
+{
+    const char* it = chunk.data();
+    const char* const end = it + chunk.size();
+    while ((it = this->skip_text(it, end)) != end) {
+        this->process(*it++);
+        if (!status_.tokens.empty()) {
+            this->drain(sink);
+        }
+    }
+}
+
+template <class SymbolType, class StatusType>
+template <class Sink>
+inline void AhoCorasickLexer<SymbolType, StatusType>::flush(Sink&& sink)
+{
+    this->flush();
+    this->drain(sink);
+}
+
+template <class SymbolType, class StatusType>
+template <class Sink>
+inline void AhoCorasickLexer<SymbolType, StatusType>::tokenize(std::string_view source, Sink&& sink)
+{
+    const char* const end = source.data() + source.size();
+    const char* text_begin = source.data();     // beginning of pending text
+    const char* it = source.data();
+
+    state_t state = 0;
+    const char* cand_begin = nullptr;
+    const char* cand_end = nullptr;
+    symbol_t cand_symbol = {};
+
+    auto emit = [&]() {
+        if (text_begin != cand_begin) {
+            sink(token_view_t(symbol_t::TEXT,
+                              std::string_view(text_begin, cand_begin - text_begin)));
+        }
+        sink(keeps_lexeme(cand_symbol) ?
+             token_view_t(cand_symbol, std::string_view(cand_begin, cand_end - cand_begin)) :
+             token_view_t(cand_symbol));
+        it = text_begin = cand_end;
+        cand_begin = nullptr;
+        state = 0;
+    };
+
+    for (;;) {
+        // no more input: candidate is final and what follows it is walked again
+        if (it == end) {
+            if (!cand_begin) {
+                break;
+            }
+            emit();
+            continue;
+        }
+
+        // nothing in progress: skip to the next char that can start a lexeme
+        if (!state && !cand_begin && (it = scanner_.find(it, end)) == end) {
+            continue;
+        }
+
+        state = table_.next(state, *it++);
+
+        if (const size_t len = table_.match_length(state)) {
+            const char* begin = it - len;
+            if (!cand_begin || begin <= cand_begin) {
+                cand_begin = begin;
+                cand_end = it;
+                cand_symbol = table_.match_symbol(state);
+            }
+        }
+
+        if (cand_begin && it - table_.depth(state) > cand_begin) {
+            emit();
+        }
+    }
+
+    if (text_begin != end) {
+        sink(token_view_t(symbol_t::TEXT,
+                          std::string_view(text_begin, end - text_begin)));
+    }
+}
+
+template <class SymbolType, class StatusType>
+inline typename AhoCorasickLexer<SymbolType, StatusType>::token_stream_t
+AhoCorasickLexer<SymbolType, StatusType>::tokenize(std::string_view source)
+{
+    token_stream_t stream(source);
+    this->tokenize(source, stream);
+    return stream;
+}
+
+////////////////////////////////////////////////////////////
+// AhoCorasickLexer Typedef
+////////////////////////////////////////////////////////////
+using aho_corasick_table_t = AhoCorasickTable<Symbol>;
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
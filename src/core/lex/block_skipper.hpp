@@ -0,0 +1,209 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <core/lex/byte_scanner.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+////////////////////////////////////////////////////////////
+// BlockSkipper
+//
+// Finds the close brace that matches an open brace
+// that has already been consumed, e.g. the end of a function body.
+// Braces inside comments, string literals and char literals are not counted.
+// A quote that follows a digit (or hex digit) is taken to be
+// a digit separator (1'000), not the beginning of a char literal.
+// Raw string literals are not recognized.
+//
+// Input may be split into chunks at arbitrary points.
+// Within every state, the next byte of interest is found with
+// a ByteScanner that looks for the few bytes that matter in that state only,
+// so e.g. the body of a comment is skipped with a search for '*' or '\n'.
+////////////////////////////////////////////////////////////
+
+struct BlockSkipper
+{
+    // Starts looking for the close brace of a new block.
+    void start();
+
+    // Consumes [first, last) up to and including the matching close brace.
+    // Returns pointer past the close brace if it was found
+    // (in which case done() is true), otherwise last.
+    const char* find(const char* first, const char* last);
+
+    // Returns true if the matching close brace has been found.
+    bool done() const;
+
+private:
+
+    enum class State : uint8_t {
+        CODE,
+        SLASH,              // '/' in code
+        LINE_COMMENT,
+        LINE_ESCAPE,        // '\' in line comment
+        BLOCK_COMMENT,
+        BLOCK_STAR,         // '*' in block comment
+        STRING,
+        STRING_ESCAPE,      // '\' in string literal
+        CHAR,
+        CHAR_ESCAPE         // '\' in char literal
+    };
+
+    static constexpr size_t n_states = 10;
+
+    static const ByteScanner& scanner(State state);
+    static bool is_separator(char prev, char prev2);
+
+    size_t depth_ = 0;              // number of open braces not yet closed
+    State state_ = State::CODE;
+    std::array<char, 2> last_ = {}; // last two bytes consumed (last_[1] is the last one)
+};
+
+////////////////////////////////////////////////////////////
+// BlockSkipper Implementation
+////////////////////////////////////////////////////////////
+
+inline void BlockSkipper::start()
+{
+    depth_ = 1;
+    state_ = State::CODE;
+    last_ = {};
+}
+
+inline bool BlockSkipper::done() const
+{
+    return depth_ == 0;
+}
+
+// Bytes that change state (or depth) in every state.
+// States that look at the very next byte only scan for every byte.
+inline const ByteScanner& BlockSkipper::scanner(State state)
+{
+    static const std::array<ByteScanner, n_states> scanners = []() {
+        auto make = [](std::string_view bytes) {
+            byte_set_t set = {};
+            for (char c : bytes) {
+                set[static_cast<unsigned char>(c)] = true;
+            }
+            return ByteScanner(set);
+        };
+        byte_set_t all;
+        all.fill(true);
+        return std::array<ByteScanner, n_states>{{
+            make("{}/\"'"),         // CODE
+            ByteScanner(all),       // SLASH
+            make("\n\\"),           // LINE_COMMENT
+            ByteScanner(all),       // LINE_ESCAPE
+            make("*"),              // BLOCK_COMMENT
+            ByteScanner(all),       // BLOCK_STAR
+            make("\"\\\n"),         // STRING
+            ByteScanner(all),       // STRING_ESCAPE
+            make("'\\\n"),          // CHAR
+            ByteScanner(all),       // CHAR_ESCAPE
+        }};
+    }();
+    return scanners[static_cast<size_t>(state)];
+}
+
+// Whether a quote after prev (preceded by prev2) is a digit separator.
+// "u8" is the only char literal prefix that ends with a digit.
+inline bool BlockSkipper::is_separator(char prev, char prev2)
+{
+    const bool is_hex = (prev >= '0' && prev <= '9') ||
+                        (prev >= 'a' && prev <= 'f') ||
+                        (prev >= 'A' && prev <= 'F');
+    return is_hex && !(prev == '8' && prev2 == 'u');
+}
+
+inline const char* BlockSkipper::find(const char* first, const char* last)
+{
+    const char* it = first;
+
+    // previous byte (and the one before) of *it, which may lie in an earlier chunk
+    auto prev = [&](size_t n) {
+        return (static_cast<size_t>(it - first) >= n) ? *(it - n) : last_[2 - n + (it - first)];
+    };
+
+    while (it != last && depth_) {
+        it = scanner(state_).find(it, last);
+        if (it == last) {
+            break;
+        }
+
+        const char c = *it;
+        switch (state_) {
+            case State::CODE:
+                switch (c) {
+                    case '{': ++depth_; break;
+                    case '}': --depth_; break;
+                    case '/': state_ = State::SLASH; break;
+                    case '"': state_ = State::STRING; break;
+                    case '\'':
+                        if (!is_separator(prev(1), prev(2))) {
+                            state_ = State::CHAR;
+                        }
+                        break;
+                    default: break;
+                }
+                break;
+            case State::SLASH:
+                if (c == '/') {
+                    state_ = State::LINE_COMMENT;
+                } else if (c == '*') {
+                    state_ = State::BLOCK_COMMENT;
+                } else {
+                    // c is code, look at it again
+                    state_ = State::CODE;
+                    continue;
+                }
+                break;
+            case State::LINE_COMMENT:
+                state_ = (c == '\n') ? State::CODE : State::LINE_ESCAPE;
+                break;
+            case State::BLOCK_COMMENT:
+                state_ = State::BLOCK_STAR;
+                break;
+            case State::BLOCK_STAR:
+                if (c == '/') {
+                    state_ = State::CODE;
+                } else if (c != '*') {
+                    state_ = State::BLOCK_COMMENT;
+                }
+                break;
+            case State::STRING:
+            case State::CHAR:
+                // unterminated literals end at newline
+                state_ = (c == '\\') ?
+                    (state_ == State::STRING ? State::STRING_ESCAPE : State::CHAR_ESCAPE) :
+                    State::CODE;
+                break;
+            case State::LINE_ESCAPE:
+                state_ = State::LINE_COMMENT;
+                break;
+            case State::STRING_ESCAPE:
+                state_ = State::STRING;
+                break;
+            case State::CHAR_ESCAPE:
+                state_ = State::CHAR;
+                break;
+        }
+        ++it;
+    }
+
+    // remember the last two bytes for the next chunk
+    const size_t n = it - first;
+    if (n >= 2) {
+        last_ = {*(it - 2), *(it - 1)};
+    } else if (n == 1) {
+        last_ = {last_[1], *(it - 1)};
+    }
+    return it;
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
@@ -0,0 +1,148 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+// Set of bytes indexed by unsigned char value.
+using byte_set_t = std::array<bool, 256>;
+
+////////////////////////////////////////////////////////////
+// ByteScanner
+//
+// Finds the first byte in a range that belongs to a fixed set of bytes.
+// The lexer uses this to find the next byte that can start a lexeme
+// so that whole runs of plain text can be skipped at once.
+//
+// If the set is small enough, every block of input is compared
+// against every byte in the set with SIMD instructions
+// (AVX2 or SSE2, whichever is enabled at compile-time).
+// Otherwise, or without either instruction set,
+// input is scanned one byte at a time with a table lookup.
+////////////////////////////////////////////////////////////
+
+struct ByteScanner
+{
+    static constexpr size_t max_needles = 32;
+
+    explicit ByteScanner(const byte_set_t& set);
+
+    // Returns pointer to the first byte in [first, last) that is in the set.
+    // If there is no such byte, returns last.
+    const char* find(const char* first, const char* last) const;
+
+    // Returns true if c is in the set.
+    bool contains(char c) const;
+
+private:
+    const char* find_scalar(const char* first, const char* last) const;
+#if defined(__AVX2__)
+    const char* find_avx2(const char* first, const char* last) const;
+#endif
+#if defined(__SSE2__)
+    const char* find_sse2(const char* first, const char* last) const;
+#endif
+
+    byte_set_t set_;                                        // membership table
+    std::array<unsigned char, max_needles> needles_ = {};   // every byte in set if it fits
+    size_t n_needles_ = 0;                                  // number of bytes in set
+};
+
+////////////////////////////////////////////////////////////
+// ByteScanner Implementation
+////////////////////////////////////////////////////////////
+
+inline ByteScanner::ByteScanner(const byte_set_t& set)
+    : set_(set)
+{
+    for (size_t i = 0; i < set_.size(); ++i) {
+        if (!set_[i]) {
+            continue;
+        }
+        if (n_needles_ < max_needles) {
+            needles_[n_needles_] = static_cast<unsigned char>(i);
+        }
+        ++n_needles_;
+    }
+}
+
+inline bool ByteScanner::contains(char c) const
+{
+    return set_[static_cast<unsigned char>(c)];
+}
+
+inline const char* ByteScanner::find_scalar(const char* first, const char* last) const
+{
+    for (; first != last; ++first) {
+        if (set_[static_cast<unsigned char>(*first)]) {
+            break;
+        }
+    }
+    return first;
+}
+
+#if defined(__AVX2__)
+inline const char* ByteScanner::find_avx2(const char* first, const char* last) const
+{
+    constexpr size_t width = sizeof(__m256i);
+    while (static_cast<size_t>(last - first) >= width) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i hits = _mm256_setzero_si256();
+        for (size_t i = 0; i < n_needles_; ++i) {
+            hits = _mm256_or_si256(hits,
+                    _mm256_cmpeq_epi8(block, _mm256_set1_epi8(static_cast<char>(needles_[i]))));
+        }
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask) {
+            return first + __builtin_ctz(mask);
+        }
+        first += width;
+    }
+    return find_scalar(first, last);
+}
+#endif
+
+#if defined(__SSE2__)
+inline const char* ByteScanner::find_sse2(const char* first, const char* last) const
+{
+    constexpr size_t width = sizeof(__m128i);
+    while (static_cast<size_t>(last - first) >= width) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i hits = _mm_setzero_si128();
+        for (size_t i = 0; i < n_needles_; ++i) {
+            hits = _mm_or_si128(hits,
+                    _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(needles_[i]))));
+        }
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        if (mask) {
+            return first + __builtin_ctz(mask);
+        }
+        first += width;
+    }
+    return find_scalar(first, last);
+}
+#endif
+
+inline const char* ByteScanner::find(const char* first, const char* last) const
+{
+    if (n_needles_ > max_needles) {
+        return find_scalar(first, last);
+    }
+#if defined(__AVX2__)
+    return find_avx2(first, last);
+#elif defined(__SSE2__)
+    return find_sse2(first, last);
+#else
+    return find_scalar(first, last);
+#endif
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
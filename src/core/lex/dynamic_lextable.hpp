@@ -0,0 +1,329 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <core/lex/byte_scanner.hpp>
+#include <core/lex/lextrie_params.hpp>
+#include <core/lex/swar_matcher.hpp>
+#include <core/symbol.hpp>
+#include <core/tag_set.hpp>
+#include <exceptions/exceptions.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+////////////////////////////////////////////////////////////
+// DynamicLexTable
+//
+// Runtime counterpart of LexTable.
+// Built once from a list of (string, symbol) pairs (like legacy_2 Trie),
+// but stored as a dense (state x byte) transition table
+// along with accept, symbol and parent arrays.
+// States are numbered in insertion order (root is state 0)
+// and since the root can never be the destination of a transition,
+// state 0 in the transition table denotes "no transition".
+//
+// The table itself is immutable once built and is shared
+// between copies, so copying a DynamicLexTable (e.g. one per lexer)
+// is as cheap as copying a pointer.
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+struct DynamicLexTable
+{
+    using symbol_t = SymbolType;
+    using state_t = uint16_t;
+    using pair_t = std::pair<std::string_view, symbol_t>;
+
+    static constexpr size_t max_states = std::numeric_limits<state_t>::max() + size_t(1);
+
+    // Table with no lexemes at all.
+    DynamicLexTable();
+
+    // Constructs table from a list of pairs of string and symbol.
+    // Strings must be non-empty (std::invalid_argument otherwise).
+    // If a string appears more than once, the last symbol associated
+    // with it is used.
+    DynamicLexTable(std::initializer_list<pair_t> pairs);
+
+    // Same as above for any range of pairs whose first element
+    // is convertible to std::string_view.
+    template <class Iter>
+    DynamicLexTable(Iter first, Iter last);
+
+    // Transition from current state with char.
+    // On transition, call functor of type OnTransition.
+    // If transition was successful, return true.
+    // Otherwise, no changes are made and returns false.
+    template <class OnTransition>
+    bool transition(char, OnTransition);
+
+    // Back transition from current state towards the root.
+    // By default, back transition once.
+    // Returns the number of times actually back transitioned.
+    size_t back_transition(size_t = 1);
+
+    // Returns true if and only if current state is accepting.
+    bool is_accept() const;
+
+    // Returns true if current state is the root.
+    bool is_reset() const;
+
+    // Sets current state to the root.
+    void reset();
+
+    const std::optional<symbol_t>& get_symbol() const;
+
+    // Returns the set of chars that have a transition from the root.
+    byte_set_t lead_bytes() const;
+
+    // Matcher of the same lexemes, for input that is known to be long enough
+    // (see LexerGeneric::tokenize).
+    const SwarMatcher<symbol_t>& swar() const;
+
+    // Returns the number of states (including the root).
+    size_t n_states() const;
+
+    // Stateless access to the table, for owners that keep
+    // the current state themselves (see ModalLexTable).
+    // next_state returns 0 if there is no transition.
+    state_t next_state(state_t state, char c) const;
+    state_t parent_state(state_t state) const;
+    const std::optional<symbol_t>& symbol_at(state_t state) const;
+
+private:
+
+    struct table_t
+    {
+        std::vector<state_t> next;                      // next[state * 256 + byte], 0 if no transition
+        std::vector<state_t> parent;                    // parent of every state (root is its own parent)
+        std::vector<std::optional<symbol_t>> symbol;    // active if and only if state is accepting
+        SwarMatcher<symbol_t> swar;                     // same lexemes
+
+        table_t();
+        void insert(std::string_view str, symbol_t symbol);
+    };
+
+    void bind();
+
+    std::shared_ptr<const table_t> table_;
+    const state_t* next_ = nullptr;                     // table_->next.data()
+    const std::optional<symbol_t>* symbol_ = nullptr;   // table_->symbol.data()
+    state_t state_ = 0;                                 // current state
+};
+
+////////////////////////////////////////////////////////////
+// DynamicLexTable Implementation
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+inline DynamicLexTable<SymbolType>::table_t::table_t()
+    : next(256, 0)
+    , parent(1, 0)
+    , symbol(1)
+{}
+
+template <class SymbolType>
+inline void DynamicLexTable<SymbolType>::table_t::insert(std::string_view str, symbol_t sym)
+{
+    if (str.empty()) {
+        throw std::invalid_argument("lexer table strings must be non-empty");
+    }
+
+    size_t state = 0;
+    for (char c : str) {
+        const size_t idx = state * 256 + static_cast<unsigned char>(c);
+        if (!next[idx]) {
+            const size_t child = parent.size();
+            if (child >= max_states) {
+                throw exceptions::exception("too many lexemes for a lexer table");
+            }
+            next[idx] = static_cast<state_t>(child);
+            next.resize(next.size() + 256, 0);
+            parent.push_back(static_cast<state_t>(state));
+            symbol.emplace_back();
+        }
+        state = next[idx];
+    }
+    symbol[state] = sym;
+}
+
+template <class SymbolType>
+inline void DynamicLexTable<SymbolType>::bind()
+{
+    next_ = table_->next.data();
+    symbol_ = table_->symbol.data();
+}
+
+template <class SymbolType>
+inline DynamicLexTable<SymbolType>::DynamicLexTable()
+    : table_(std::make_shared<const table_t>())
+{
+    this->bind();
+}
+
+template <class SymbolType>
+inline DynamicLexTable<SymbolType>::DynamicLexTable(std::initializer_list<pair_t> pairs)
+    : DynamicLexTable(pairs.begin(), pairs.end())
+{}
+
+template <class SymbolType>
+template <class Iter>
+inline DynamicLexTable<SymbolType>::DynamicLexTable(Iter first, Iter last)
+{
+    auto table = std::make_shared<table_t>();
+    table->swar = SwarMatcher<symbol_t>(first, last);
+    for (; first != last; ++first) {
+        table->insert(std::string_view(first->first), first->second);
+    }
+    table_ = std::move(table);
+    this->bind();
+}
+
+template <class SymbolType>
+template <class OnTransition>
+inline bool
+DynamicLexTable<SymbolType>::transition(char c, OnTransition transfunc)
+{
+    const state_t next = this->next_state(state_, c);
+    if (next) {
+        state_ = next;
+        transfunc();
+        return true;
+    }
+    return false;
+}
+
+template <class SymbolType>
+inline size_t DynamicLexTable<SymbolType>::back_transition(size_t num)
+{
+    size_t back_num = 0;
+    for (; back_num < num && state_; ++back_num) {
+        state_ = this->parent_state(state_);
+    }
+    return back_num;
+}
+
+template <class SymbolType>
+inline bool DynamicLexTable<SymbolType>::is_accept() const
+{
+    return symbol_[state_].has_value();
+}
+
+template <class SymbolType>
+inline bool DynamicLexTable<SymbolType>::is_reset() const
+{
+    return state_ == 0;
+}
+
+template <class SymbolType>
+inline void DynamicLexTable<SymbolType>::reset()
+{
+    state_ = 0;
+}
+
+template <class SymbolType>
+inline const std::optional<typename DynamicLexTable<SymbolType>::symbol_t>&
+DynamicLexTable<SymbolType>::get_symbol() const
+{
+    return symbol_[state_];
+}
+
+template <class SymbolType>
+inline byte_set_t DynamicLexTable<SymbolType>::lead_bytes() const
+{
+    byte_set_t set = {};
+    for (size_t c = 0; c < set.size(); ++c) {
+        set[c] = (next_[c] != 0);
+    }
+    return set;
+}
+
+template <class SymbolType>
+inline const SwarMatcher<SymbolType>& DynamicLexTable<SymbolType>::swar() const
+{
+    return table_->swar;
+}
+
+template <class SymbolType>
+inline size_t DynamicLexTable<SymbolType>::n_states() const
+{
+    return table_->parent.size();
+}
+
+template <class SymbolType>
+inline typename DynamicLexTable<SymbolType>::state_t
+DynamicLexTable<SymbolType>::next_state(state_t state, char c) const
+{
+    return next_[state * 256 + static_cast<unsigned char>(c)];
+}
+
+template <class SymbolType>
+inline typename DynamicLexTable<SymbolType>::state_t
+DynamicLexTable<SymbolType>::parent_state(state_t state) const
+{
+    return table_->parent[state];
+}
+
+template <class SymbolType>
+inline const std::optional<typename DynamicLexTable<SymbolType>::symbol_t>&
+DynamicLexTable<SymbolType>::symbol_at(state_t state) const
+{
+    return symbol_[state];
+}
+
+////////////////////////////////////////////////////////////
+// DynamicLexTable Typedef
+////////////////////////////////////////////////////////////
+using dynamic_lextable_t = DynamicLexTable<Symbol>;
+
+// Every lexeme of lextrie_params_t along with its symbol
+// plus "@<tag>" as Symbol::TAG for every tag in tag_set and in tags
+// that does not already have a symbol of its own (e.g. "param").
+inline std::vector<std::pair<std::string, Symbol>>
+make_lexeme_symbol_pairs(const std::vector<std::string>& tags = {})
+{
+    std::vector<std::pair<std::string, Symbol>> pairs(
+            lexeme_symbol_arr.begin(), lexeme_symbol_arr.end());
+
+    auto add_tag = [&pairs](const std::string& tag) {
+        if (tag.empty()) {
+            return;
+        }
+        std::string lexeme = '@' + tag;
+        for (const auto& pair : pairs) {
+            if (pair.first == lexeme) {
+                return;
+            }
+        }
+        pairs.emplace_back(std::move(lexeme), Symbol::TAG);
+    };
+
+    for (const std::string& tag : tag_set) {
+        add_tag(tag);
+    }
+    for (const std::string& tag : tags) {
+        add_tag(tag);
+    }
+
+    return pairs;
+}
+
+// Builds a table from make_lexeme_symbol_pairs(tags).
+inline dynamic_lextable_t make_dynamic_lextable(const std::vector<std::string>& tags = {})
+{
+    const auto pairs = make_lexeme_symbol_pairs(tags);
+    return dynamic_lextable_t(pairs.begin(), pairs.end());
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
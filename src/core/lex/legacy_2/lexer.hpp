@@ -8,17 +8,20 @@ namespace docgen {
 namespace core {
 namespace lex {
 
-struct Lexer
+// StatusType determines the queue that holds resolved tokens
+// (e.g. Status<Token<Symbol>, RingQueue<Token<Symbol>>>).
+template <class StatusType>
+struct BasicLexer
 {
     using symbol_t = Symbol;
-    using token_t = Token<symbol_t>;
-    using status_t = Status<token_t>;
+    using status_t = StatusType;
+    using token_t = typename status_t::token_t;
 
-    Lexer();
+    BasicLexer();
 
     void process(char c);
     void flush();
-    std::optional<Lexer::token_t> next_token();
+    std::optional<token_t> next_token();
 
 private:
 
@@ -42,29 +45,34 @@ private:
     status_t status_;
 };
 
-inline void Lexer::tokenize_text()
+template <class StatusType>
+inline void BasicLexer<StatusType>::tokenize_text()
 {
     if (!text_.empty()) {
         status_.tokens.emplace(symbol_t::TEXT, std::move(text_));
     }
 }
 
-inline bool Lexer::is_backtracking() const
+template <class StatusType>
+inline bool BasicLexer<StatusType>::is_backtracking() const
 {
     return state_ == State::backtrack;
 }
 
-inline void Lexer::set_backtracking()
+template <class StatusType>
+inline void BasicLexer<StatusType>::set_backtracking()
 {
     state_ = State::backtrack;
 }
 
-inline void Lexer::reset_backtracking()
+template <class StatusType>
+inline void BasicLexer<StatusType>::reset_backtracking()
 {
     state_ = State::non_backtrack;
 }
 
-inline void Lexer::update_state()
+template <class StatusType>
+inline void BasicLexer<StatusType>::update_state()
 {
     // if current state is accepting
     if (trie_.is_accept()) {
@@ -77,7 +85,9 @@ inline void Lexer::update_state()
     }
 }
 
-inline std::optional<Lexer::token_t> Lexer::next_token() 
+template <class StatusType>
+inline std::optional<typename BasicLexer<StatusType>::token_t>
+BasicLexer<StatusType>::next_token() 
 {
     if (!status_.tokens.empty()) {
         token_t token = std::move(status_.tokens.front());
@@ -87,7 +97,8 @@ inline std::optional<Lexer::token_t> Lexer::next_token()
     return {};
 }
 
-inline void Lexer::reset()
+template <class StatusType>
+inline void BasicLexer<StatusType>::reset()
 {
     text_.clear();
     buf_.clear();
@@ -99,7 +110,8 @@ inline void Lexer::reset()
 // Lexer Implementation
 ///////////////////////////////////
 
-inline Lexer::Lexer()
+template <class StatusType>
+inline BasicLexer<StatusType>::BasicLexer()
     : trie_({
             {"\n", Symbol::NEWLINE},
             {";", Symbol::SEMICOLON},
@@ -114,7 +126,8 @@ inline Lexer::Lexer()
             })
 {}
 
-inline void Lexer::process(char c)
+template <class StatusType>
+inline void BasicLexer<StatusType>::process(char c)
 {
     this->update_state();
 
@@ -146,7 +159,8 @@ inline void Lexer::process(char c)
     this->backtrack(c); 
 }
 
-inline void Lexer::backtrack(char c)
+template <class StatusType>
+inline void BasicLexer<StatusType>::backtrack(char c)
 {
     // tokenize text
     this->tokenize_text(); 
@@ -173,7 +187,8 @@ inline void Lexer::backtrack(char c)
     }
 }
 
-inline void Lexer::flush()
+template <class StatusType>
+inline void BasicLexer<StatusType>::flush()
 {
     this->update_state();
 
@@ -189,6 +204,8 @@ inline void Lexer::flush()
     this->reset();
 }
 
+using Lexer = BasicLexer<Status<Token<Symbol>>>;
+
 } // namespace lex
 } // namespace core
 } // namespace docgen
@@ -1,9 +1,17 @@
 #pragma once 
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <cassert>
+#include <core/lex/block_skipper.hpp>
 #include <core/lex/lextrie.hpp>
+#include <core/lex/lextable.hpp>
+#include <core/lex/dynamic_lextable.hpp>
+#include <core/lex/modal_lextable.hpp>
 #include <core/lex/status.hpp>
+#include <core/lex/swar_matcher.hpp>
+#include <core/lex/token_stream.hpp>
 #include <core/symbol.hpp>
 #include <core/token.hpp>
 
@@ -11,83 +19,225 @@ namespace docgen {
 namespace core {
 namespace lex {
 
-template <class LexTrieType>
+// Tokens resolved by the lexer are held in a RingQueue by default,
+// so that the usual handful of pending tokens never allocates.
+template <class SymbolType>
+using lexer_status_t = Status<Token<SymbolType>, RingQueue<Token<SymbolType>>>;
+
+template <class LexTrieType
+        , class StatusType = lexer_status_t<typename LexTrieType::symbol_t>
+        >
 struct LexerGeneric
 {
     using lexer_trie_t = LexTrieType;
     using symbol_t = typename lexer_trie_t::symbol_t;
-    using token_t = Token<symbol_t>;
-    using status_t = Status<token_t>;
+    using status_t = StatusType;
+    using token_t = typename status_t::token_t;
+    using token_view_t = TokenView<symbol_t>;
+    using token_stream_t = TokenStream<symbol_t>;
+
+    // Everything needed to continue lexing from where the snapshot was taken.
+    // The trie position itself is not stored: it is fully determined by
+    // the first walked chars of buf, which are walked again on restore.
+    // Tokens already resolved (i.e. waiting in the token queue) are not part of it.
+    struct snapshot_t
+    {
+        std::string text;               // pending text
+        bool text_marked = false;       // see text_marked_
+        std::optional<token_t> run;     // see run_
+        std::string buf;                // see buf_
+        size_t walked = 0;              // see pos_
+        size_t accept_len = 0;          // see accept_len_
+        symbol_t accept_symbol = {};    // see accept_symbol_
+        size_t offset = 0;              // see offset()
+        LexMode mode = LexMode::CODE;   // lexing mode (modal backends only)
+        bool paused = false;            // see paused_
+        bool skip_requested = false;    // see skip_requested_
+        bool skipping = false;          // see skipping_
+        BlockSkipper skipper;           // see skipper_
+    };
+
+    // Runtime backends (e.g. DynamicLexTable) must be passed in already built.
+    explicit LexerGeneric(lexer_trie_t trie = lexer_trie_t());
 
     void process(char c);
     void flush();
     std::optional<token_t> next_token();
 
+    // Processes every character of chunk in order.
+    // Lexer state carries across calls, so input may be split into chunks at arbitrary points.
+    // Resolved tokens are left in the token queue to be retrieved with next_token().
+    void process(std::string_view chunk);
+
+    // Processes every character of chunk in order.
+    // Every token resolved along the way is moved into sink,
+    // which must be callable with token_t&&.
+    template <class Sink>
+    void process(std::string_view chunk, Sink&& sink);
+
+    // Flushes the lexer and moves every remaining token into sink.
+    template <class Sink>
+    void flush(Sink&& sink);
+
+    // Lexes the whole of source at once and passes every token to sink
+    // as a token_view_t, which sink must be callable with.
+    // TEXT content refers into source instead of being copied,
+    // so tokens must not be used after source is released or modified.
+    // Independent of any state left by process(),
+    // i.e. source is lexed as if it were the entire input.
+    template <class Sink>
+    void tokenize(std::string_view source, Sink&& sink);
+
+    // Lexes the whole of source at once into a compact token stream
+    // that refers into source (see TokenStream).
+    token_stream_t tokenize(std::string_view source);
+
+    // Number of chars processed since construction or the last restore
+    // (plus the offset of the restored snapshot). Unaffected by flush.
+    size_t offset() const;
+
+    // Returns true if no lexeme is in progress and no block is being skipped,
+    // i.e. at most text (or a run, see coalesce()) is pending.
+    // The state is then fully described by the pending text, run and offset.
+    bool is_quiet() const;
+
+    // Captures the current state. Cheap to copy: besides pending text,
+    // it holds no more than the longest lexeme plus one char.
+    snapshot_t snapshot() const;
+
+    // Continues from snapshot, which must have been taken from a lexer
+    // with the same vocabulary. Any token still in the token queue is discarded.
+    void restore(const snapshot_t& snapshot);
+
+    // Requests that input be skipped up to the close brace matching
+    // the open brace resolved last (e.g. the end of a function body).
+    // Of the skipped input, only the close brace is resolved (see BlockSkipper).
+    // Only honored right after the open brace was resolved, 
+    // i.e. from within the sink or after retrieving it with next_token(),
+    // before any more input is processed. Returns whether it was honored.
+    bool skip_block();
+
+    // Tells whether content of TEXT tokens resolved from here on will be read
+    // (e.g. Parser::needs_text). While it is not, text found by scanning
+    // is only marked as present instead of being copied,
+    // so TEXT tokens are still resolved where they would be, 
+    // but with partial or empty content.
+    // Only takes effect at the next text, i.e. the text pending
+    // when called keeps whatever content it has. Wanted by default.
+    void want_text(bool wanted);
+
+    // Sets whether tokenize() matches lexemes with the SwarMatcher
+    // of the backend (if it has one, see DynamicLexTable::swar)
+    // wherever enough input is left, instead of walking the backend.
+    // Off by default: walking a table is about as fast on typical sources,
+    // where most lexemes are one char long (see lexer_shootout_benchmark).
+    void use_swar(bool enabled);
+
+    // Sets whether consecutive tokens of symbols that coalesce (see coalesces())
+    // are resolved as a single token whose content holds the whole run,
+    // e.g. one WHITESPACE token with content "\t\t  " instead of four tokens.
+    // A run is only resolved once the token after it is,
+    // so text that follows a run is lexed before the run is retrieved
+    // (see want_text). Off by default.
+    void coalesce(bool enabled);
+
 private:
 
+    template <class Sink>
+    void drain(Sink& sink);
+
+    // If no lexeme is in progress, appends every char in [first, last)
+    // up until the next char that can start a lexeme to text_ at once
+    // (or marks it if text is not wanted).
+    // Returns pointer to the first char that was not consumed.
+    const char* skip_text(const char* first, const char* last);
+
+    // Walks the trie over every char in buf_ starting at pos_.
+    // Whenever a char fails to transition, the longest accepted prefix (if any)
+    // is tokenized and walking restarts right after it within buf_.
+    // On return, every char of buf_ has been walked, i.e. pos_ == buf_.size(),
+    // unless an open brace was tokenized (see paused_).
+    void resume();
+
+    // Continues after a pause, skipping the block if requested.
+    void unpause();
+
+    // Feeds [first, last) to skipper_ and tokenizes the close brace once found.
+    // Returns pointer past the close brace if found, otherwise last.
+    const char* skip_body(const char* first, const char* last);
+
+    static constexpr bool opens_block(symbol_t symbol);
+
+    // Tokenizes text_ and the symbol accepted at accept_len_,
+    // then drops the accepted prefix from buf_ and resets the trie.
+    void tokenize_accept();
+
     void tokenize_text();
-    bool is_backtracking() const;
-    void set_backtracking();
-    void reset_backtracking();
-    void backtrack(char c);
-    void update_state();
+    void tokenize_run();
     void reset();
 
-    enum class State : bool {
-        backtrack,
-        non_backtrack
-    };
-    
+    // Modal backends (see ModalLexTable) are told about every resolved symbol
+    // and supply the scanner of their current mode.
+    // Other backends always use scanner_.
+    static void on_symbol(lexer_trie_t& trie, symbol_t symbol);
+    static void reset_mode(lexer_trie_t& trie);
+    const ByteScanner& scanner(const lexer_trie_t& trie) const;
+
+    // Backends with a SwarMatcher (see DynamicLexTable::swar) supply it
+    // for their current mode if use_swar() was set. Others supply none.
+    const SwarMatcher<symbol_t>* swar(const lexer_trie_t& trie) const;
+
     lexer_trie_t trie_;
     std::string text_;
-    std::string buf_;
-    State state_ = State::non_backtrack;
+    bool text_wanted_ = true;       // see want_text()
+    bool text_marked_ = false;      // text was found but not copied to text_
+    bool coalesce_ = false;         // see coalesce()
+    bool use_swar_ = false;         // see use_swar()
+    std::optional<token_t> run_;    // run of coalesced tokens not yet resolved
+    std::string buf_;               // chars walked since the root, followed by chars yet to be walked
+    size_t pos_ = 0;                // number of chars of buf_ walked
+    size_t accept_len_ = 0;         // length of longest accepted prefix of buf_ (0 if none)
+    symbol_t accept_symbol_ = {};   // symbol of longest accepted prefix of buf_
+    size_t offset_ = 0;             // number of chars processed
+    bool paused_ = false;           // open brace was just tokenized, rest of buf_ is yet to be walked
+    bool skip_requested_ = false;   // skip_block() was called while paused
+    bool skipping_ = false;         // looking for the close brace with skipper_
+    BlockSkipper skipper_;
     status_t status_;
+    ByteScanner scanner_ = ByteScanner(trie_.lead_bytes());
 };
 
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::tokenize_text()
-{
-    if (!text_.empty()) {
-        status_.tokens.emplace(symbol_t::TEXT, std::move(text_));
-    }
-}
-
-template <class LexTrieType>
-inline bool LexerGeneric<LexTrieType>::is_backtracking() const
-{
-    return state_ == State::backtrack;
-}
-
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::set_backtracking()
+template <class LexTrieType, class StatusType>
+inline LexerGeneric<LexTrieType, StatusType>::LexerGeneric(lexer_trie_t trie)
+    : trie_(std::move(trie))
 {
-    state_ = State::backtrack;
+    trie_.reset();
 }
 
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::reset_backtracking()
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::tokenize_run()
 {
-    state_ = State::non_backtrack;
+    if (run_) {
+        status_.tokens.emplace(std::move(*run_));
+        run_.reset();
+    }
 }
 
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::update_state()
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::tokenize_text()
 {
-    // if current state is accepting
-    if (trie_.is_accept()) {
-        if (!this->is_backtracking()) {
-            this->set_backtracking();
-        }
-        // ignore contents in buffer up until now
-        // this optimization can be done because we look for longest match
-        buf_.clear();
+    // a pending run always precedes pending text
+    this->tokenize_run();
+    if (!text_.empty() || text_marked_) {
+        status_.tokens.emplace(symbol_t::TEXT, std::move(text_));
+        text_.clear();
+        text_marked_ = false;
     }
 }
 
-template <class LexTrieType>
-inline std::optional<typename LexerGeneric<LexTrieType>::token_t> 
-LexerGeneric<LexTrieType>::next_token() 
+template <class LexTrieType, class StatusType>
+inline std::optional<typename LexerGeneric<LexTrieType, StatusType>::token_t> 
+LexerGeneric<LexTrieType, StatusType>::next_token() 
 {
     if (!status_.tokens.empty()) {
         token_t token = std::move(status_.tokens.front());
@@ -97,95 +247,544 @@ LexerGeneric<LexTrieType>::next_token()
     return {};
 }
 
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::reset()
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::reset()
 {
     text_.clear();
+    text_marked_ = false;
+    run_.reset();
     buf_.clear();
+    pos_ = 0;
+    accept_len_ = 0;
+    paused_ = false;
+    skip_requested_ = false;
+    skipping_ = false;
     trie_.reset();
-    reset_backtracking();
+    reset_mode(trie_);
 }
 
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::process(char c)
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::on_symbol(lexer_trie_t& trie, symbol_t symbol)
 {
-    this->update_state();
+    if constexpr (details::is_modal_v<lexer_trie_t>) {
+        trie.on_symbol(symbol);
+    }
+}
 
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::reset_mode(lexer_trie_t& trie)
+{
+    if constexpr (details::is_modal_v<lexer_trie_t>) {
+        trie.set_mode(LexMode::CODE);
+    }
+}
+
+template <class LexTrieType, class StatusType>
+inline const ByteScanner& 
+LexerGeneric<LexTrieType, StatusType>::scanner(const lexer_trie_t& trie) const
+{
+    if constexpr (details::is_modal_v<lexer_trie_t>) {
+        return trie.scanner();
+    } else {
+        return scanner_;
+    }
+}
+
+template <class LexTrieType, class StatusType>
+inline const SwarMatcher<typename LexerGeneric<LexTrieType, StatusType>::symbol_t>*
+LexerGeneric<LexTrieType, StatusType>::swar([[maybe_unused]] const lexer_trie_t& trie) const
+{
+    if constexpr (details::has_swar_v<lexer_trie_t>) {
+        return use_swar_ ? &trie.swar() : nullptr;
+    } else {
+        return nullptr;
+    }
+}
+
+template <class LexTrieType, class StatusType>
+inline constexpr bool LexerGeneric<LexTrieType, StatusType>::opens_block(symbol_t symbol)
+{
+    if constexpr (block_symbols<symbol_t>::enabled) {
+        return symbol == block_symbols<symbol_t>::open;
+    } else {
+        return false;
+    }
+}
+
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::process(char c)
+{
+    ++offset_;
+
+    // rare case: an open brace was just tokenized or a block is being skipped
+    if (paused_ || skipping_) {
+        if (paused_) {
+            this->unpause();
+        }
+        if (skipping_) {
+            this->skip_body(&c, &c + 1);
+            return;
+        }
+        // paused again: c is walked after the new open brace has been retrieved
+        if (paused_) {
+            buf_.push_back(c);
+            return;
+        }
+    }
+
+    // usual case: c extends the current walk or is plain text at the root
     bool transitioned = trie_.transition(c, 
             [this, c]() {
                 this->buf_.push_back(c);
+                ++this->pos_;
             }
         );
 
-    // if transition exists
     if (transitioned) {
+        if (trie_.is_accept()) {
+            accept_len_ = pos_;
+            accept_symbol_ = *trie_.get_symbol();
+        }
         return;
     }
 
-    // otherwise, no transition exists
-    
-    // if not backtracking
-    if (!this->is_backtracking()) {
-        // if trie at root
-        if (trie_.is_reset()) {
+    if (buf_.empty()) {
+        if (text_wanted_) {
             text_.push_back(c);
-            return;
+        } else {
+            text_marked_ = true;
         }
-        text_.append(buf_);
-        buf_.clear();
-        trie_.reset();
-        return this->process(c);
+        return;
     }
-    
-    // otherwise, currently backtracking
-    this->backtrack(c); 
+
+    // otherwise, c ends the current walk
+    buf_.push_back(c);
+    this->resume();
 }
 
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::backtrack(char c)
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::tokenize_accept()
 {
-    // tokenize text
-    this->tokenize_text(); 
+    if (coalesce_ && coalesces(accept_symbol_)) {
+        // extend the pending run unless text or another run comes in between
+        const bool extends = run_ && run_->name == accept_symbol_ &&
+                             text_.empty() && !text_marked_;
+        if (!extends) {
+            this->tokenize_text();
+            run_.emplace(accept_symbol_, std::string());
+        }
+        run_->content.append(buf_, 0, accept_len_);
+    } else {
+        this->tokenize_text();
+        if (keeps_lexeme(accept_symbol_)) {
+            status_.tokens.emplace(accept_symbol_, buf_.substr(0, accept_len_));
+        } else {
+            status_.tokens.emplace(accept_symbol_);
+        }
+    }
+    buf_.erase(0, accept_len_);
+    pos_ = 0;
+    accept_len_ = 0;
+    trie_.reset();
+    on_symbol(trie_, accept_symbol_);
+
+    // let the open brace be retrieved before anything after it is walked,
+    // so that the block can still be skipped
+    paused_ = opens_block(accept_symbol_);
+}
 
-    // tokenize symbol
-    trie_.back_transition(buf_.size());
-    assert(trie_.is_accept());
-    auto opt_symbol = trie_.get_symbol();
-    assert(static_cast<bool>(opt_symbol));
-    status_.tokens.emplace(*opt_symbol);
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::resume()
+{
+    // buf_ never holds more than the longest lexeme plus one char,
+    // since new chars are only appended once all of buf_ has been walked
+    // and every restart drops at least the accepted prefix.
+    while (pos_ < buf_.size()) {
+        const char c = buf_[pos_];
 
-    // move and clear buf_ to temp string for reprocessing
-    std::string reprocess_str(std::move(buf_));
-    reprocess_str.push_back(c);
+        if (trie_.transition(c, [](){})) {
+            ++pos_;
+            if (trie_.is_accept()) {
+                accept_len_ = pos_;
+                accept_symbol_ = *trie_.get_symbol();
+            }
+            continue;
+        }
 
-    // reset 
-    this->reset();
-    
-    // reprocess the rest
-    for (char c : reprocess_str) {
-        this->process(c);
+        // longest match found: chars after it are walked again from the root
+        if (accept_len_) {
+            this->tokenize_accept();
+            if (paused_) {
+                return;
+            }
+            continue;
+        }
+
+        // no lexeme starts at the beginning of buf_:
+        // walked chars become text and c is walked again from the root,
+        // or c becomes text as well if it failed at the root
+        const size_t n_text = pos_ ? pos_ : 1;
+        text_.append(buf_, 0, n_text);
+        buf_.erase(0, n_text);
+        pos_ = 0;
+        trie_.reset();
+    }
+}
+
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::unpause()
+{
+    paused_ = false;
+    if (skip_requested_) {
+        skip_requested_ = false;
+        skipping_ = true;
+        skipper_.start();
+        const char* first = buf_.data();
+        buf_.erase(0, this->skip_body(first, first + buf_.size()) - first);
+        if (skipping_) {
+            return;
+        }
+    }
+    this->resume();
+}
+
+template <class LexTrieType, class StatusType>
+inline const char* LexerGeneric<LexTrieType, StatusType>::skip_body(const char* first, const char* last)
+{
+    const char* next = skipper_.find(first, last);
+    if constexpr (block_symbols<symbol_t>::enabled) {
+        if (skipper_.done()) {
+            skipping_ = false;
+            status_.tokens.emplace(block_symbols<symbol_t>::close);
+            // the close brace is always in code
+            reset_mode(trie_);
+        }
+    }
+    return next;
+}
+
+template <class LexTrieType, class StatusType>
+inline bool LexerGeneric<LexTrieType, StatusType>::skip_block()
+{
+    if (!paused_) {
+        return false;
     }
+    skip_requested_ = true;
+    return true;
+}
+
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::want_text(bool wanted)
+{
+    text_wanted_ = wanted;
+}
+
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::use_swar(bool enabled)
+{
+    use_swar_ = enabled;
+}
+
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::coalesce(bool enabled)
+{
+    coalesce_ = enabled;
 }
 
-template <class LexTrieType>
-inline void LexerGeneric<LexTrieType>::flush()
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::flush()
 {
-    this->update_state();
+    // skip the block if requested after the last open brace
+    if (paused_) {
+        this->unpause();
+    }
 
-    if (this->is_backtracking()) {
-        return this->backtrack(0);
+    // tokenize the longest match, walk what follows it
+    // and repeat until no accepted prefix is pending
+    // (no more blocks can be skipped from here)
+    while (!skipping_ && (paused_ || accept_len_)) {
+        if (!paused_) {
+            this->tokenize_accept();
+        }
+        paused_ = false;
+        this->resume();
     }
 
-    // non-backtracking: no parent is an accepting node
-    // append buf_ to text_ and tokenize text_
+    // no prefix of buf_ is accepted
+    // append buf_ to text_ and tokenize pending run and text_
     // reset all other fields
     text_.append(buf_);
     this->tokenize_text();
     this->reset();
 }
 
+template <class LexTrieType, class StatusType>
+template <class Sink>
+inline void LexerGeneric<LexTrieType, StatusType>::drain(Sink& sink)
+{
+    // token is popped before sink is called since sink may call skip_block()
+    while (!status_.tokens.empty()) {
+        token_t token = std::move(status_.tokens.front());
+        status_.tokens.pop();
+        sink(std::move(token));
+    }
+}
+
+template <class LexTrieType, class StatusType>
+inline const char* LexerGeneric<LexTrieType, StatusType>::skip_text(const char* first, const char* last)
+{
+    if (skipping_) {
+        const char* next = this->skip_body(first, last);
+        offset_ += next - first;
+        first = next;
+    }
+
+    // chars that cannot start a lexeme at the root always become text
+    if (!buf_.empty() || paused_ || skipping_) {
+        return first;
+    }
+    const char* next = this->scanner(trie_).find(first, last);
+    if (text_wanted_) {
+        text_.append(first, next);
+    } else if (next != first) {
+        text_marked_ = true;
+    }
+    offset_ += next - first;
+    return next;
+}
+
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::process(std::string_view chunk)
+{
+    const char* it = chunk.data();
+    const char* const end = it + chunk.size();
+    while ((it = this->skip_text(it, end)) != end) {
+        this->process(*it++);
+    }
+}
+
+template <class LexTrieType, class StatusType>
+template <class Sink>
+inline void LexerGeneric<LexTrieType, StatusType>::process(std::string_view chunk, Sink&& sink)
+{
+    const char* it = chunk.data();
+    const char* const end = it + chunk.size();
+    while ((it = this->skip_text(it, end)) != end) {
+        this->process(*it++);
+        // most characters resolve no token
+        if (!status_.tokens.empty()) {
+            this->drain(sink);
+        }
+    }
+    // close brace of a block skipped up to the end
+    this->drain(sink);
+}
+
+template <class LexTrieType, class StatusType>
+template <class Sink>
+inline void LexerGeneric<LexTrieType, StatusType>::flush(Sink&& sink)
+{
+    this->flush();
+    this->drain(sink);
+}
+
+template <class LexTrieType, class StatusType>
+template <class Sink>
+inline void LexerGeneric<LexTrieType, StatusType>::tokenize(std::string_view source, Sink&& sink)
+{
+    const char* const end = source.data() + source.size();
+    const char* text_begin = source.data();     // beginning of pending text
+    const char* it = source.data();             // beginning of possible lexeme
+    std::optional<token_view_t> run;            // pending run (see coalesce())
+
+    // a pending run always precedes pending text
+    auto sink_text = [&](const char* text_end) {
+        if (run) {
+            sink(std::move(*run));
+            run.reset();
+        }
+        if (text_begin != text_end) {
+            sink(token_view_t(symbol_t::TEXT, 
+                              std::string_view(text_begin, text_end - text_begin)));
+        }
+    };
+
+    lexer_trie_t trie = trie_;
+    trie.reset();
+    reset_mode(trie);
+    const SwarMatcher<symbol_t>* matcher = this->swar(trie);    // changes with mode only
+
+    while ((it = this->scanner(trie).find(it, end)) != end) {
+        const char* walk = it;
+        const char* accept_end = nullptr;
+        symbol_t symbol = {};
+
+        // with enough input left, match with a single load
+        // and skip past the chars a walk would have gone through
+        size_t reach = 0;
+        if (matcher && (reach = matcher->reach(*it)) &&
+            static_cast<size_t>(end - it) >= reach) {
+            const auto match = matcher->match(it);
+            if (match.len) {
+                walk = accept_end = it + match.len;
+                symbol = match.symbol;
+            } else {
+                walk = it + match.walked;
+            }
+        } else {
+            // walk as far as possible, remembering the last accepting position
+            while (walk != end && trie.transition(*walk, [](){})) {
+                ++walk;
+                if (trie.is_accept()) {
+                    accept_end = walk;
+                }
+            }
+            if (accept_end) {
+                trie.back_transition(walk - accept_end);
+                assert(trie.is_accept());
+                auto opt_symbol = trie.get_symbol();
+                assert(static_cast<bool>(opt_symbol));
+                symbol = *opt_symbol;
+            }
+        }
+
+        // no lexeme starts at it: walked chars become text
+        // and the char that failed to transition is looked at again from the root
+        if (!accept_end) {
+            trie.reset();
+            it = (walk == it) ? walk + 1 : walk;
+            continue;
+        }
+
+        trie.reset();
+        on_symbol(trie, symbol);
+        matcher = this->swar(trie);
+
+        // extend the pending run unless text or another run comes in between
+        if (coalesce_ && coalesces(symbol)) {
+            if (run && run->name == symbol && text_begin == it) {
+                run->content = std::string_view(run->content.data(), accept_end - run->content.data());
+            } else {
+                sink_text(it);
+                run.emplace(symbol, std::string_view(it, accept_end - it));
+            }
+            it = text_begin = accept_end;
+            continue;
+        }
+
+        // tokenize run, text and symbol
+        sink_text(it);
+        const bool paused = std::exchange(paused_, opens_block(symbol));
+        sink(keeps_lexeme(symbol) ?
+             token_view_t(symbol, std::string_view(it, accept_end - it)) :
+             token_view_t(symbol));
+        paused_ = paused;
+
+        it = text_begin = accept_end;
+
+        // sink asked to skip the block just opened
+        if constexpr (block_symbols<symbol_t>::enabled) {
+            if (opens_block(symbol) && std::exchange(skip_requested_, false)) {
+                BlockSkipper skipper;
+                skipper.start();
+                it = text_begin = skipper.find(it, end);
+                if (!skipper.done()) {
+                    break;
+                }
+                sink(token_view_t(block_symbols<symbol_t>::close));
+                reset_mode(trie);
+                matcher = this->swar(trie);
+            }
+        }
+    }
+
+    sink_text(end);
+}
+
+template <class LexTrieType, class StatusType>
+inline typename LexerGeneric<LexTrieType, StatusType>::token_stream_t
+LexerGeneric<LexTrieType, StatusType>::tokenize(std::string_view source)
+{
+    token_stream_t stream(source);
+    this->tokenize(source, stream);
+    return stream;
+}
+
+template <class LexTrieType, class StatusType>
+inline size_t LexerGeneric<LexTrieType, StatusType>::offset() const
+{
+    return offset_;
+}
+
+template <class LexTrieType, class StatusType>
+inline bool LexerGeneric<LexTrieType, StatusType>::is_quiet() const
+{
+    return buf_.empty() && !paused_ && !skipping_;
+}
+
+template <class LexTrieType, class StatusType>
+inline typename LexerGeneric<LexTrieType, StatusType>::snapshot_t
+LexerGeneric<LexTrieType, StatusType>::snapshot() const
+{
+    snapshot_t snapshot;
+    snapshot.text = text_;
+    snapshot.text_marked = text_marked_;
+    snapshot.run = run_;
+    snapshot.buf = buf_;
+    snapshot.walked = pos_;
+    snapshot.accept_len = accept_len_;
+    snapshot.accept_symbol = accept_symbol_;
+    snapshot.offset = offset_;
+    snapshot.paused = paused_;
+    snapshot.skip_requested = skip_requested_;
+    snapshot.skipping = skipping_;
+    snapshot.skipper = skipper_;
+    if constexpr (details::is_modal_v<lexer_trie_t>) {
+        snapshot.mode = trie_.mode();
+    }
+    return snapshot;
+}
+
+template <class LexTrieType, class StatusType>
+inline void LexerGeneric<LexTrieType, StatusType>::restore(const snapshot_t& snapshot)
+{
+    assert(snapshot.walked <= snapshot.buf.size());
+    assert(snapshot.accept_len <= snapshot.walked);
+
+    text_ = snapshot.text;
+    text_marked_ = snapshot.text_marked;
+    run_ = snapshot.run;
+    buf_ = snapshot.buf;
+    pos_ = snapshot.walked;
+    accept_len_ = snapshot.accept_len;
+    accept_symbol_ = snapshot.accept_symbol;
+    offset_ = snapshot.offset;
+    paused_ = snapshot.paused;
+    skip_requested_ = snapshot.skip_requested;
+    skipping_ = snapshot.skipping;
+    skipper_ = snapshot.skipper;
+    status_.tokens = decltype(status_.tokens)();
+
+    // walk the trie back to where it was
+    if constexpr (details::is_modal_v<lexer_trie_t>) {
+        trie_.set_mode(snapshot.mode);
+    }
+    trie_.reset();
+    for (size_t i = 0; i < pos_; ++i) {
+        [[maybe_unused]] const bool transitioned = trie_.transition(buf_[i], [](){});
+        assert(transitioned);
+    }
+}
+
 using Lexer = LexerGeneric<lextrie_t>;
 
+// Lexer whose vocabulary is built at runtime (see make_dynamic_lextable).
+using DynamicLexer = LexerGeneric<dynamic_lextable_t>;
+
+// Lexer that only looks for the lexemes that matter inside or outside comments
+// (see make_modal_lextable).
+using ModalLexer = LexerGeneric<modal_lextable_t>;
+
 } // namespace lex
 } // namespace core
 } // namespace docgen
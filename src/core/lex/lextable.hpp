@@ -0,0 +1,267 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <core/lex/lextrie.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+////////////////////////////////////////////////////////////
+// LexTable
+//
+// Flattened form of LexTrie.
+// TrieParams is expected to be a result of calling trie_params_t.
+// Every node of the trie described by TrieParams is numbered in pre-order
+// (root is state 0) and a dense (state x byte) transition table
+// is generated at compile-time along with accept, symbol and parent arrays.
+// A transition is then a single table lookup instead of
+// a chain of std::visit and utils::map lookups.
+//
+// Since the root can never be the destination of a transition,
+// state 0 in the transition table denotes "no transition".
+////////////////////////////////////////////////////////////
+
+namespace details {
+
+// Number of nodes in the trie described by TrieParams.
+template <class TrieParams>
+struct lextable_size
+{
+private:
+    using subtrie_info_t = utils::get_t<TrieParams, 1>;
+
+    template <size_t... I>
+    static constexpr size_t evaluate(std::index_sequence<I...>)
+    {
+        return 1 + (... + lextable_size<
+                utils::get_t<utils::get_t<subtrie_info_t, I>, 0>
+                >::value);
+    }
+
+public:
+    static constexpr size_t value = evaluate(
+            std::make_index_sequence<utils::size_v<subtrie_info_t>>());
+};
+
+template <>
+struct lextable_size<utils::leaf_tag>
+{
+    static constexpr size_t value = 1;
+};
+
+// Smallest unsigned type that can index every state.
+template <size_t N>
+using lextable_state_t = std::conditional_t<
+    (N <= UINT8_MAX + 1), uint8_t,
+    std::conditional_t<(N <= UINT16_MAX + 1), uint16_t, uint32_t>
+>;
+
+template <class StateType, class SymbolType, size_t N>
+struct lextable_data
+{
+    using state_t = StateType;
+    using symbol_t = SymbolType;
+
+    std::array<std::array<state_t, 256>, N> next = {};  // next[state][byte], 0 if no transition
+    std::array<state_t, N> parent = {};                 // parent of every state (root is its own parent)
+    std::array<uint8_t, N> depth = {};                  // number of transitions from root
+    std::array<bool, N> accept = {};                    // whether state is accepting
+    std::array<symbol_t, N> symbol = {};                // only meaningful if accept[state] is true
+};
+
+// Fills table with the subtrie described by TrieParams rooted at state.
+// States are assigned in pre-order starting from next_free.
+// Returns the next free state after all of the subtrie's nodes have been assigned.
+template <class TrieParams>
+struct lextable_builder
+{
+private:
+    using char_list_t = utils::get_t<TrieParams, 0>;
+    using subtrie_info_t = utils::get_t<TrieParams, 1>;
+
+    template <size_t I, class TableType>
+    static constexpr size_t fill_child(TableType& table, size_t state, size_t next_free)
+    {
+        using info_t = utils::get_t<subtrie_info_t, I>;
+        using state_t = typename TableType::state_t;
+
+        constexpr unsigned char c = utils::get_v<char_list_t, I>;
+        const size_t child = next_free;
+
+        table.next[state][c] = static_cast<state_t>(child);
+        table.parent[child] = static_cast<state_t>(state);
+        table.depth[child] = table.depth[state] + 1;
+        table.accept[child] = utils::get_t<info_t, 1>::value;
+        table.symbol[child] = utils::get_t<info_t, 2>::value;
+
+        return lextable_builder<utils::get_t<info_t, 0>>::fill(table, child, child + 1);
+    }
+
+    template <class TableType, size_t... I>
+    static constexpr size_t fill(TableType& table, size_t state, size_t next_free,
+                                 std::index_sequence<I...>)
+    {
+        ((next_free = fill_child<I>(table, state, next_free)), ...);
+        return next_free;
+    }
+
+public:
+    template <class TableType>
+    static constexpr size_t fill(TableType& table, size_t state, size_t next_free)
+    {
+        return fill(table, state, next_free,
+                    std::make_index_sequence<utils::size_v<char_list_t>>());
+    }
+};
+
+template <>
+struct lextable_builder<utils::leaf_tag>
+{
+    template <class TableType>
+    static constexpr size_t fill(TableType&, size_t, size_t next_free)
+    {
+        return next_free;
+    }
+};
+
+} // namespace details
+
+template <class TrieParams
+        , class SymbolType = details::get_symbol_type_t<TrieParams>
+        >
+struct LexTable
+{
+    using symbol_t = SymbolType;
+
+    static constexpr size_t n_states = details::lextable_size<TrieParams>::value;
+
+    using state_t = details::lextable_state_t<n_states>;
+
+    // Transition from current state with char.
+    // On transition, call functor of type OnTransition.
+    // If transition was successful, return true.
+    // Otherwise, no changes are made and returns false.
+    template <class OnTransition>
+    bool transition(char, OnTransition);
+
+    // Back transition from current state towards the root.
+    // By default, back transition once.
+    // Returns the number of times actually back transitioned.
+    size_t back_transition(size_t = 1);
+
+    // Returns true if and only if current state is accepting.
+    bool is_accept() const;
+
+    // Returns true if current state is the root.
+    bool is_reset() const;
+
+    // Sets current state to the root.
+    void reset();
+
+    const std::optional<symbol_t>& get_symbol() const;
+
+    // Returns the set of chars that have a transition from the root.
+    static constexpr byte_set_t lead_bytes();
+
+private:
+
+    using table_t = details::lextable_data<state_t, symbol_t, n_states>;
+
+    static constexpr table_t make_table()
+    {
+        table_t table;
+        details::lextable_builder<TrieParams>::fill(table, 0, 1);
+        return table;
+    }
+
+    template <size_t... I>
+    static constexpr auto make_symbols(std::index_sequence<I...>)
+    {
+        using opt_symbol_t = std::optional<symbol_t>;
+        return std::array<opt_symbol_t, n_states>{{
+            (table_.accept[I] ? opt_symbol_t(table_.symbol[I]) : opt_symbol_t())...
+        }};
+    }
+
+    static constexpr table_t table_ = make_table();
+    static constexpr std::array<std::optional<symbol_t>, n_states> symbols_ =
+        make_symbols(std::make_index_sequence<n_states>());
+
+    state_t state_ = 0;     // current state
+};
+
+////////////////////////////////////////////////////////////
+// LexTable Implementation
+////////////////////////////////////////////////////////////
+
+template <class TrieParams, class SymbolType>
+template <class OnTransition>
+inline bool
+LexTable<TrieParams, SymbolType>::transition(char c, OnTransition transfunc)
+{
+    const state_t next = table_.next[state_][static_cast<unsigned char>(c)];
+    if (next) {
+        state_ = next;
+        transfunc();
+        return true;
+    }
+    return false;
+}
+
+template <class TrieParams, class SymbolType>
+inline size_t LexTable<TrieParams, SymbolType>::back_transition(size_t num)
+{
+    size_t back_num = 0;
+    for (; back_num < num && state_; ++back_num) {
+        state_ = table_.parent[state_];
+    }
+    return back_num;
+}
+
+template <class TrieParams, class SymbolType>
+inline bool LexTable<TrieParams, SymbolType>::is_accept() const
+{
+    return table_.accept[state_];
+}
+
+template <class TrieParams, class SymbolType>
+inline bool LexTable<TrieParams, SymbolType>::is_reset() const
+{
+    return state_ == 0;
+}
+
+template <class TrieParams, class SymbolType>
+inline void LexTable<TrieParams, SymbolType>::reset()
+{
+    state_ = 0;
+}
+
+template <class TrieParams, class SymbolType>
+inline const std::optional<typename LexTable<TrieParams, SymbolType>::symbol_t>&
+LexTable<TrieParams, SymbolType>::get_symbol() const
+{
+    return symbols_[state_];
+}
+
+template <class TrieParams, class SymbolType>
+inline constexpr byte_set_t LexTable<TrieParams, SymbolType>::lead_bytes()
+{
+    byte_set_t set = {};
+    for (size_t c = 0; c < set.size(); ++c) {
+        set[c] = (table_.next[0][c] != 0);
+    }
+    return set;
+}
+
+////////////////////////////////////////////////////////////
+// LexTable Typedef
+////////////////////////////////////////////////////////////
+using lextable_t = LexTable<lextrie_params_t>;
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
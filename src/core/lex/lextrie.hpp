@@ -1,6 +1,7 @@
 #pragma once
 #include <optional>
 #include <variant>
+#include <core/lex/byte_scanner.hpp>
 #include <core/lex/lextrie_params.hpp>
 #include <core/utils/map.hpp>
 
@@ -64,6 +65,9 @@ struct LexTrie
 
     const std::optional<symbol_t>& get_symbol() const;
 
+    // Returns the set of chars that have a transition from the root.
+    static constexpr byte_set_t lead_bytes();
+
 private:
 
     ////////////////////////////////////////
@@ -113,6 +117,14 @@ private:
         });
     }
 
+    template <size_t... I>
+    static constexpr byte_set_t lead_bytes(std::index_sequence<I...>)
+    {
+        byte_set_t set = {};
+        ((set[static_cast<unsigned char>(utils::get_v<char_list_t, I>)] = true), ...);
+        return set;
+    }
+
     static constexpr auto make_children()
     {
         return make_children(std::make_index_sequence<utils::size_v<char_list_t>>());
@@ -162,6 +174,9 @@ public:
     
     const std::optional<symbol_t>& get_symbol() const;
 
+    // Returns an empty set since it never contains any children.
+    static constexpr byte_set_t lead_bytes();
+
 private:
 
     bool is_root_ = false;
@@ -273,6 +288,12 @@ LexTrie<TrieParams, SymbolType>::get_symbol() const
     return symbol_;
 }
 
+template <class TrieParams, class SymbolType>
+inline constexpr byte_set_t LexTrie<TrieParams, SymbolType>::lead_bytes()
+{
+    return lead_bytes(std::make_index_sequence<utils::size_v<char_list_t>>());
+}
+
 ////////////////////////////////////////////////////////////
 // LexTrie Implementation (Specialization)
 ////////////////////////////////////////////////////////////
@@ -315,6 +336,12 @@ LexTrie<utils::leaf_tag, SymbolType>::get_symbol() const
     return symbol_;
 }
 
+template <class SymbolType>
+inline constexpr byte_set_t LexTrie<utils::leaf_tag, SymbolType>::lead_bytes()
+{
+    return {};
+}
+
 ////////////////////////////////////////////////////////////
 // LexTrie Typedef 
 ////////////////////////////////////////////////////////////
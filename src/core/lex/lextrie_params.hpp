@@ -87,42 +87,43 @@ static constexpr auto make_trie_params_input()
     );
 }
 
+// Every lexeme the lexer recognizes along with its symbol.
+// Also used to build lexers at runtime (see dynamic_lextable.hpp).
+inline constexpr auto lexeme_symbol_arr = 
+    make_pair_array<std::string_view, Symbol>({
+        {"\n", Symbol::NEWLINE},
+        {" ", Symbol::WHITESPACE},
+        {"\t", Symbol::WHITESPACE},
+        {"\v", Symbol::WHITESPACE},
+        {"\r", Symbol::WHITESPACE},
+        {"\f", Symbol::WHITESPACE},
+        {";", Symbol::SEMICOLON},
+        {"#", Symbol::HASHTAG},
+        {"*", Symbol::STAR},
+        {"{", Symbol::OPEN_BRACE},
+        {"}", Symbol::CLOSE_BRACE},
+        {"<", Symbol::OPEN_ANGLE_BRACKET},
+        {">", Symbol::CLOSE_ANGLE_BRACKET},
+        {"/", Symbol::FORWARD_SLASH},
+        {"///", Symbol::BEGIN_SLINE_COMMENT},
+        {"/*!", Symbol::BEGIN_SBLOCK_COMMENT},
+        {"//", Symbol::BEGIN_NLINE_COMMENT},
+        {"/*", Symbol::BEGIN_NBLOCK_COMMENT},
+        {"*/", Symbol::END_BLOCK_COMMENT},
+        {"template", Symbol::TEMPLATE},
+        {"class", Symbol::CLASS},
+        {"struct", Symbol::STRUCT},
+        {"@sdesc", Symbol::SDESC},
+        {"@tparam", Symbol::TPARAM},
+        {"@param", Symbol::PARAM},
+        {"@return", Symbol::RETURN}
+    });
+
 struct LexTrieParamsGenerator 
 {
-private:
-    static constexpr auto string_symbol_arr = 
-        make_pair_array<std::string_view, Symbol>({
-            {"\n", Symbol::NEWLINE},
-            {" ", Symbol::WHITESPACE},
-            {"\t", Symbol::WHITESPACE},
-            {"\v", Symbol::WHITESPACE},
-            {"\r", Symbol::WHITESPACE},
-            {"\f", Symbol::WHITESPACE},
-            {";", Symbol::SEMICOLON},
-            {"#", Symbol::HASHTAG},
-            {"*", Symbol::STAR},
-            {"{", Symbol::OPEN_BRACE},
-            {"}", Symbol::CLOSE_BRACE},
-	    {"<", Symbol::OPEN_ANGLE_BRACKET },
-	    {">", Symbol::CLOSE_ANGLE_BRACKET },
-            {"/", Symbol::FORWARD_SLASH},
-            {"///", Symbol::BEGIN_SLINE_COMMENT},
-            {"/*!", Symbol::BEGIN_SBLOCK_COMMENT},
-            {"//", Symbol::BEGIN_NLINE_COMMENT},
-            {"/*", Symbol::BEGIN_NBLOCK_COMMENT},
-            {"*/", Symbol::END_BLOCK_COMMENT},
-	    {"template", Symbol::TEMPLATE },
-	    {"class", Symbol::CLASS },
-	    {"struct", Symbol::STRUCT },
-            {"@sdesc", Symbol::SDESC},
-            {"@tparam", Symbol::TPARAM},
-            {"@param", Symbol::PARAM},
-            {"@return", Symbol::RETURN}
-        });
-
 public:
     using type = utils::trie_params_t<
-        std::decay_t<decltype(make_trie_params_input<string_symbol_arr>())>
+        std::decay_t<decltype(make_trie_params_input<lexeme_symbol_arr>())>
     >;
 };
 
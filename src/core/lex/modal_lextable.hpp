@@ -0,0 +1,261 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <core/lex/byte_scanner.hpp>
+#include <core/lex/dynamic_lextable.hpp>
+#include <core/symbol.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+// Context in which input is being lexed.
+enum class LexMode : uint8_t {
+    CODE,           // outside comments
+    DOC_LINE,       // after "///" until newline
+    DOC_BLOCK,      // after "/*!" until "*/"
+    LINE_COMMENT,   // after "//" until newline
+    BLOCK_COMMENT   // after "/*" until "*/"
+};
+
+////////////////////////////////////////////////////////////
+// ModalLexTable
+//
+// Lexer backend made of one DynamicLexTable per LexMode,
+// each holding only the lexemes that matter in that mode:
+//
+//  - CODE: every lexeme except tags.
+//  - DOC_LINE, DOC_BLOCK: every lexeme except language keywords.
+//    Punctuation and whitespace are kept so that text is split
+//    (and whitespace normalized) exactly as in code.
+//  - LINE_COMMENT: newline only.
+//  - BLOCK_COMMENT: "*/" and newline only
+//    (newline is kept for line-oriented consumers, e.g. "#" lines).
+//
+// LexerGeneric calls on_symbol() with every symbol it resolves,
+// which switches mode on comment openers and closers.
+// Bodies of plain comments are then skipped with the scanner of their mode,
+// which looks for one or two bytes only.
+//
+// Like DynamicLexTable, the tables are immutable once built
+// and shared between copies. Each copy only owns its mode
+// and its state in the table of that mode.
+////////////////////////////////////////////////////////////
+
+struct ModalLexTable
+{
+    using symbol_t = Symbol;
+    using table_t = DynamicLexTable<symbol_t>;
+
+    static constexpr size_t n_modes = 5;
+
+    // Tables built from make_lexeme_symbol_pairs().
+    ModalLexTable();
+
+    // Tables built from a list of pairs of string and symbol (see DynamicLexTable).
+    // Lexemes starting with '@' only go to the doc comment modes,
+    // language keywords only to code.
+    template <class Iter>
+    ModalLexTable(Iter first, Iter last);
+
+    // Same interface as DynamicLexTable on the table of the current mode.
+    template <class OnTransition>
+    bool transition(char c, OnTransition transfunc);
+    size_t back_transition(size_t num = 1);
+    bool is_accept() const                              { return table_->symbol_at(state_).has_value(); }
+    bool is_reset() const                               { return state_ == 0; }
+    void reset()                                        { state_ = 0; }
+    const std::optional<symbol_t>& get_symbol() const   { return table_->symbol_at(state_); }
+    byte_set_t lead_bytes() const                       { return table_->lead_bytes(); }
+    const SwarMatcher<symbol_t>& swar() const           { return table_->swar(); }
+
+    // Switches mode if symbol opens or closes a comment in the current mode.
+    void on_symbol(symbol_t symbol);
+
+    LexMode mode() const;
+
+    // Switches to mode and resets the current state to its root.
+    void set_mode(LexMode mode);
+
+    // Finds bytes that can start a lexeme in the current mode.
+    const ByteScanner& scanner() const;
+
+private:
+
+    struct modes_t
+    {
+        std::array<table_t, n_modes> tables;
+        std::vector<ByteScanner> scanners;      // one per mode
+    };
+
+    // Only the current state is per-lexer: switching modes repoints table_
+    // into the shared tables and never touches the shared_ptr refcount.
+    std::shared_ptr<const modes_t> modes_;
+    const table_t* table_ = nullptr;            // &modes_->tables[mode_]
+    table_t::state_t state_ = 0;                // current state in *table_
+    LexMode mode_ = LexMode::CODE;
+};
+
+namespace details {
+
+// Whether lexer backend LexTrieType switches modes (see ModalLexTable).
+template <class LexTrieType, class = void>
+struct is_modal : std::false_type
+{};
+
+template <class LexTrieType>
+struct is_modal<LexTrieType, std::void_t<
+    decltype(std::declval<LexTrieType&>().on_symbol(
+                std::declval<typename LexTrieType::symbol_t>()))
+    >> : std::true_type
+{};
+
+template <class LexTrieType>
+inline constexpr bool is_modal_v = is_modal<LexTrieType>::value;
+
+} // namespace details
+
+////////////////////////////////////////////////////////////
+// ModalLexTable Implementation
+////////////////////////////////////////////////////////////
+
+inline ModalLexTable::ModalLexTable()
+{
+    const auto pairs = make_lexeme_symbol_pairs();
+    *this = ModalLexTable(pairs.begin(), pairs.end());
+}
+
+template <class Iter>
+inline ModalLexTable::ModalLexTable(Iter first, Iter last)
+{
+    std::vector<std::pair<std::string, symbol_t>> code;
+    std::vector<std::pair<std::string, symbol_t>> doc;
+    for (; first != last; ++first) {
+        const std::string lexeme(first->first);
+        const symbol_t symbol = first->second;
+        const bool is_tag = !lexeme.empty() && lexeme.front() == '@';
+        const bool is_keyword = symbol == Symbol::TEMPLATE ||
+                                symbol == Symbol::CLASS ||
+                                symbol == Symbol::STRUCT;
+        if (!is_tag) {
+            code.emplace_back(lexeme, symbol);
+        }
+        if (!is_keyword) {
+            doc.emplace_back(lexeme, symbol);
+        }
+    }
+
+    auto modes = std::make_shared<modes_t>();
+    const table_t doc_table(doc.begin(), doc.end());
+    modes->tables[static_cast<size_t>(LexMode::CODE)] = table_t(code.begin(), code.end());
+    modes->tables[static_cast<size_t>(LexMode::DOC_LINE)] = doc_table;
+    modes->tables[static_cast<size_t>(LexMode::DOC_BLOCK)] = doc_table;
+    modes->tables[static_cast<size_t>(LexMode::LINE_COMMENT)] = table_t{
+        {"\n", Symbol::NEWLINE}
+    };
+    modes->tables[static_cast<size_t>(LexMode::BLOCK_COMMENT)] = table_t{
+        {"\n", Symbol::NEWLINE},
+        {"*/", Symbol::END_BLOCK_COMMENT}
+    };
+    for (const table_t& table : modes->tables) {
+        modes->scanners.emplace_back(table.lead_bytes());
+    }
+
+    modes_ = std::move(modes);
+    this->set_mode(LexMode::CODE);
+}
+
+template <class OnTransition>
+inline bool ModalLexTable::transition(char c, OnTransition transfunc)
+{
+    const table_t::state_t next = table_->next_state(state_, c);
+    if (next) {
+        state_ = next;
+        transfunc();
+        return true;
+    }
+    return false;
+}
+
+inline size_t ModalLexTable::back_transition(size_t num)
+{
+    size_t back_num = 0;
+    for (; back_num < num && state_; ++back_num) {
+        state_ = table_->parent_state(state_);
+    }
+    return back_num;
+}
+
+inline void ModalLexTable::on_symbol(symbol_t symbol)
+{
+    switch (mode_) {
+        case LexMode::CODE:
+            switch (symbol) {
+                case Symbol::BEGIN_SLINE_COMMENT:
+                    this->set_mode(LexMode::DOC_LINE);
+                    break;
+                case Symbol::BEGIN_SBLOCK_COMMENT:
+                    this->set_mode(LexMode::DOC_BLOCK);
+                    break;
+                case Symbol::BEGIN_NLINE_COMMENT:
+                    this->set_mode(LexMode::LINE_COMMENT);
+                    break;
+                case Symbol::BEGIN_NBLOCK_COMMENT:
+                    this->set_mode(LexMode::BLOCK_COMMENT);
+                    break;
+                default:
+                    break;
+            }
+            break;
+        case LexMode::DOC_LINE:
+        case LexMode::LINE_COMMENT:
+            if (symbol == Symbol::NEWLINE) {
+                this->set_mode(LexMode::CODE);
+            }
+            break;
+        case LexMode::DOC_BLOCK:
+        case LexMode::BLOCK_COMMENT:
+            if (symbol == Symbol::END_BLOCK_COMMENT) {
+                this->set_mode(LexMode::CODE);
+            }
+            break;
+    }
+}
+
+inline LexMode ModalLexTable::mode() const
+{
+    return mode_;
+}
+
+inline void ModalLexTable::set_mode(LexMode mode)
+{
+    mode_ = mode;
+    table_ = &modes_->tables[static_cast<size_t>(mode)];
+    state_ = 0;
+}
+
+inline const ByteScanner& ModalLexTable::scanner() const
+{
+    return modes_->scanners[static_cast<size_t>(mode_)];
+}
+
+////////////////////////////////////////////////////////////
+// ModalLexTable Typedef
+////////////////////////////////////////////////////////////
+using modal_lextable_t = ModalLexTable;
+
+// Builds a modal table from make_lexeme_symbol_pairs(tags).
+inline modal_lextable_t make_modal_lextable(const std::vector<std::string>& tags = {})
+{
+    const auto pairs = make_lexeme_symbol_pairs(tags);
+    return modal_lextable_t(pairs.begin(), pairs.end());
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
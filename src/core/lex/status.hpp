@@ -1,19 +1,267 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
 #include <queue>
+#include <type_traits>
+#include <utility>
 
 namespace docgen {
 namespace core {
 namespace lex {
 
-template <class TokenType>
+////////////////////////////////////////////////////////////
+// RingQueue
+//
+// FIFO queue with the same interface as the parts of std::queue
+// that the lexers use (empty, size, front, push, emplace, pop).
+// Elements are stored in a circular buffer that lives inside the object,
+// so as long as no more than InlineCapacity elements are held at once,
+// no memory is ever allocated.
+// If the queue is full on push, the buffer moves to the heap
+// with double the capacity. Capacity never shrinks,
+// so once the largest burst has been seen, nothing is allocated again.
+////////////////////////////////////////////////////////////
+
+template <class T, size_t InlineCapacity = 4>
+struct RingQueue
+{
+    static_assert(InlineCapacity && !(InlineCapacity & (InlineCapacity - 1)),
+                  "InlineCapacity must be a power of 2");
+
+    using value_type = T;
+    using size_type = size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    static constexpr size_t inline_capacity = InlineCapacity;
+
+    RingQueue() = default;
+    RingQueue(const RingQueue&);
+    RingQueue(RingQueue&&);
+    RingQueue& operator=(const RingQueue&);
+    RingQueue& operator=(RingQueue&&);
+    ~RingQueue();
+
+    bool empty() const;
+    size_t size() const;
+
+    // Number of elements that can be held without allocating.
+    size_t capacity() const;
+
+    T& front();
+    const T& front() const;
+
+    // Allocates only if size() == capacity().
+    void push(const T&);
+    void push(T&&);
+    template <class... Args>
+    T& emplace(Args&&...);
+
+    void pop();
+
+    // Destroys every element but keeps capacity.
+    void clear();
+
+private:
+    using slot_t = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    T* at(size_t i);
+    const T* at(size_t i) const;
+    void grow();
+    void take(RingQueue&);
+
+    std::array<slot_t, InlineCapacity> inline_;     // storage until first growth
+    std::unique_ptr<slot_t[]> heap_;                // storage after first growth
+    slot_t* slots_ = inline_.data();                // storage in use
+    size_t head_ = 0;                               // slot of front element
+    size_t size_ = 0;                               // number of elements
+    size_t mask_ = InlineCapacity - 1;              // capacity - 1
+};
+
+template <class TokenType
+        , class TokenArrType = std::queue<TokenType>
+        >
 struct Status
 {
     using token_t = TokenType;
-    using token_arr_t = std::queue<token_t>;
+    using token_arr_t = TokenArrType;
 
     token_arr_t tokens;
 };
 
+////////////////////////////////////////////////////////////
+// RingQueue Implementation
+////////////////////////////////////////////////////////////
+
+// Returns i-th element from the front.
+template <class T, size_t InlineCapacity>
+inline T* RingQueue<T, InlineCapacity>::at(size_t i)
+{
+    return std::launder(reinterpret_cast<T*>(&slots_[(head_ + i) & mask_]));
+}
+
+template <class T, size_t InlineCapacity>
+inline const T* RingQueue<T, InlineCapacity>::at(size_t i) const
+{
+    return std::launder(reinterpret_cast<const T*>(&slots_[(head_ + i) & mask_]));
+}
+
+template <class T, size_t InlineCapacity>
+inline RingQueue<T, InlineCapacity>::RingQueue(const RingQueue& other)
+{
+    *this = other;
+}
+
+template <class T, size_t InlineCapacity>
+inline RingQueue<T, InlineCapacity>::RingQueue(RingQueue&& other)
+{
+    this->take(other);
+}
+
+template <class T, size_t InlineCapacity>
+inline RingQueue<T, InlineCapacity>&
+RingQueue<T, InlineCapacity>::operator=(const RingQueue& other)
+{
+    if (this != &other) {
+        this->clear();
+        for (size_t i = 0; i < other.size_; ++i) {
+            this->push(*other.at(i));
+        }
+    }
+    return *this;
+}
+
+template <class T, size_t InlineCapacity>
+inline RingQueue<T, InlineCapacity>&
+RingQueue<T, InlineCapacity>::operator=(RingQueue&& other)
+{
+    if (this != &other) {
+        this->clear();
+        this->take(other);
+    }
+    return *this;
+}
+
+template <class T, size_t InlineCapacity>
+inline RingQueue<T, InlineCapacity>::~RingQueue()
+{
+    this->clear();
+}
+
+// Moves every element of other into this, which must be empty.
+// Heap storage is stolen as a whole; inline elements are moved one by one.
+template <class T, size_t InlineCapacity>
+inline void RingQueue<T, InlineCapacity>::take(RingQueue& other)
+{
+    if (other.heap_) {
+        heap_ = std::move(other.heap_);
+        slots_ = heap_.get();
+        head_ = other.head_;
+        size_ = other.size_;
+        mask_ = other.mask_;
+        other.slots_ = other.inline_.data();
+        other.head_ = other.size_ = 0;
+        other.mask_ = InlineCapacity - 1;
+        return;
+    }
+    for (size_t i = 0; i < other.size_; ++i) {
+        this->push(std::move(*other.at(i)));
+    }
+    other.clear();
+}
+
+template <class T, size_t InlineCapacity>
+inline bool RingQueue<T, InlineCapacity>::empty() const
+{
+    return size_ == 0;
+}
+
+template <class T, size_t InlineCapacity>
+inline size_t RingQueue<T, InlineCapacity>::size() const
+{
+    return size_;
+}
+
+template <class T, size_t InlineCapacity>
+inline size_t RingQueue<T, InlineCapacity>::capacity() const
+{
+    return mask_ + 1;
+}
+
+template <class T, size_t InlineCapacity>
+inline T& RingQueue<T, InlineCapacity>::front()
+{
+    return *this->at(0);
+}
+
+template <class T, size_t InlineCapacity>
+inline const T& RingQueue<T, InlineCapacity>::front() const
+{
+    return *this->at(0);
+}
+
+template <class T, size_t InlineCapacity>
+inline void RingQueue<T, InlineCapacity>::push(const T& value)
+{
+    this->emplace(value);
+}
+
+template <class T, size_t InlineCapacity>
+inline void RingQueue<T, InlineCapacity>::push(T&& value)
+{
+    this->emplace(std::move(value));
+}
+
+template <class T, size_t InlineCapacity>
+template <class... Args>
+inline T& RingQueue<T, InlineCapacity>::emplace(Args&&... args)
+{
+    if (size_ == this->capacity()) {
+        this->grow();
+    }
+    T* elt = new (&slots_[(head_ + size_) & mask_]) T(std::forward<Args>(args)...);
+    ++size_;
+    return *elt;
+}
+
+template <class T, size_t InlineCapacity>
+inline void RingQueue<T, InlineCapacity>::pop()
+{
+    this->front().~T();
+    head_ = (head_ + 1) & mask_;
+    --size_;
+}
+
+template <class T, size_t InlineCapacity>
+inline void RingQueue<T, InlineCapacity>::clear()
+{
+    while (!this->empty()) {
+        this->pop();
+    }
+    head_ = 0;
+}
+
+template <class T, size_t InlineCapacity>
+inline void RingQueue<T, InlineCapacity>::grow()
+{
+    const size_t new_capacity = 2 * this->capacity();
+    std::unique_ptr<slot_t[]> new_heap(new slot_t[new_capacity]);
+
+    // move elements to the beginning of new storage in order
+    for (size_t i = 0; i < size_; ++i) {
+        T* elt = this->at(i);
+        new (&new_heap[i]) T(std::move(*elt));
+        elt->~T();
+    }
+
+    heap_ = std::move(new_heap);
+    slots_ = heap_.get();
+    head_ = 0;
+    mask_ = new_capacity - 1;
+}
+
 } // namespace lex
 } // namespace core
 } // namespace docgen
@@ -0,0 +1,226 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+////////////////////////////////////////////////////////////
+// SwarMatcher
+//
+// Matches lexemes with one 8-byte load instead of walking a trie
+// one char at a time.
+// Every lexeme is stored as a word holding its first 8 chars (zero-padded)
+// along with a mask of their length, grouped by first char
+// and longest first, so that the lexeme at the beginning of a word
+// is the first one for which (word & mask) == value
+// (and, for the odd lexeme longer than 8 chars, whose remaining chars follow).
+//
+// Gives the same result as walking a trie built from the same lexemes:
+// the longest lexeme at the beginning of input if any,
+// otherwise the number of chars the trie walk would get through
+// (the longest common prefix with any lexeme).
+// May read as many chars as the longest lexeme with the same first char,
+// and at least 8 (see reach()): the caller must fall back to the trie
+// when less input is left, i.e. at the end of a buffer.
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+struct SwarMatcher
+{
+    using symbol_t = SymbolType;
+    using word_t = uint64_t;
+
+    static constexpr size_t width = sizeof(word_t);
+
+    struct match_t
+    {
+        size_t len = 0;         // length of the longest lexeme (0 if none)
+        size_t walked = 0;      // if none, length of the longest common prefix with any lexeme
+        symbol_t symbol = {};   // symbol of the longest lexeme
+    };
+
+    // Matcher with no lexemes at all.
+    SwarMatcher() = default;
+
+    // Constructs matcher from a range of pairs of string and symbol,
+    // as DynamicLexTable does. If a string appears more than once,
+    // the last symbol associated with it is used.
+    template <class Iter>
+    SwarMatcher(Iter first, Iter last);
+
+    // Returns the number of chars match() may read from input starting with c,
+    // or 0 if no lexeme starts with c.
+    size_t reach(char c) const;
+
+    // Matches at the beginning of [first, first + reach(*first)).
+    // Requires reach(*first) != 0.
+    match_t match(const char* first) const;
+
+private:
+
+    struct lexeme_t
+    {
+        word_t value;           // first chars
+        word_t mask;            // 0xff for every first char
+        uint32_t len;
+        symbol_t symbol;
+    };
+
+    static word_t load(const char* first);
+
+    // Number of equal leading chars of two words loaded with load().
+    static size_t common_prefix(word_t diff);
+
+    std::vector<lexeme_t> lexemes_;                         // grouped by first char, longest first
+    std::vector<std::string> tails_;                        // chars after the first width chars of every lexeme
+    std::array<uint16_t, 257> begin_ = {};                  // lexemes of first char c are [begin_[c], begin_[c + 1])
+    std::array<uint8_t, 256> reach_ = {};                   // see reach(), 0 if lexemes are too long
+};
+
+////////////////////////////////////////////////////////////
+// SwarMatcher Implementation
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+template <class Iter>
+inline SwarMatcher<SymbolType>::SwarMatcher(Iter first, Iter last)
+{
+    std::vector<std::pair<std::string_view, symbol_t>> pairs;
+    for (; first != last; ++first) {
+        const std::string_view str(first->first);
+        if (str.empty()) {
+            continue;
+        }
+        // last symbol wins
+        auto it = std::find_if(pairs.begin(), pairs.end(),
+                               [str](const auto& p) { return p.first == str; });
+        if (it != pairs.end()) {
+            it->second = first->second;
+        } else {
+            pairs.emplace_back(str, first->second);
+        }
+    }
+
+    std::stable_sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+        const auto ca = static_cast<unsigned char>(a.first.front());
+        const auto cb = static_cast<unsigned char>(b.first.front());
+        return (ca != cb) ? ca < cb : a.first.size() > b.first.size();
+    });
+
+    for (const auto& [str, symbol] : pairs) {
+        const size_t head = std::min(str.size(), width);
+        std::array<char, width> value = {};
+        std::array<unsigned char, width> mask = {};
+        std::memcpy(value.data(), str.data(), head);
+        std::fill_n(mask.begin(), head, 0xff);
+        lexemes_.push_back({load(value.data()),
+                            load(reinterpret_cast<const char*>(mask.data())),
+                            static_cast<uint32_t>(str.size()), symbol});
+        tails_.emplace_back(str.substr(head));
+    }
+
+    for (size_t c = 0, i = 0; c < reach_.size(); ++c) {
+        begin_[c] = static_cast<uint16_t>(i);
+        if (i < pairs.size() && static_cast<unsigned char>(pairs[i].first.front()) == c) {
+            // longest first
+            const size_t reach = std::max(pairs[i].first.size(), width);
+            reach_[c] = (reach <= std::numeric_limits<uint8_t>::max()) ? reach : 0;
+        }
+        while (i < pairs.size() && static_cast<unsigned char>(pairs[i].first.front()) == c) {
+            ++i;
+        }
+    }
+    begin_.back() = static_cast<uint16_t>(lexemes_.size());
+}
+
+template <class SymbolType>
+inline typename SwarMatcher<SymbolType>::word_t
+SwarMatcher<SymbolType>::load(const char* first)
+{
+    word_t word;
+    std::memcpy(&word, first, width);
+    return word;
+}
+
+template <class SymbolType>
+inline size_t SwarMatcher<SymbolType>::common_prefix(word_t diff)
+{
+    if (!diff) {
+        return width;
+    }
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return __builtin_clzll(diff) / 8;
+#else
+    return __builtin_ctzll(diff) / 8;
+#endif
+}
+
+template <class SymbolType>
+inline size_t SwarMatcher<SymbolType>::reach(char c) const
+{
+    return reach_[static_cast<unsigned char>(c)];
+}
+
+template <class SymbolType>
+inline typename SwarMatcher<SymbolType>::match_t
+SwarMatcher<SymbolType>::match(const char* first) const
+{
+    const word_t word = load(first);
+    const auto c = static_cast<unsigned char>(*first);
+    match_t match;
+    for (size_t i = begin_[c]; i < begin_[c + 1]; ++i) {
+        const lexeme_t& lexeme = lexemes_[i];
+        const word_t diff = (word ^ lexeme.value) & lexeme.mask;
+        size_t common = common_prefix(diff);
+        if (!diff && lexeme.len > width) {
+            const std::string& tail = tails_[i];
+            const char* rest = first + width;
+            common = 0;
+            while (common < tail.size() && rest[common] == tail[common]) {
+                ++common;
+            }
+            common += width;
+        }
+        if (common >= lexeme.len) {
+            match.len = lexeme.len;
+            match.symbol = lexeme.symbol;
+            return match;
+        }
+        match.walked = std::max(match.walked, common);
+    }
+    return match;
+}
+
+namespace details {
+
+// Whether lexer backend LexTrieType supplies a SwarMatcher
+// of its lexemes (see DynamicLexTable::swar).
+template <class LexTrieType, class = void>
+struct has_swar : std::false_type
+{};
+
+template <class LexTrieType>
+struct has_swar<LexTrieType, std::void_t<
+    decltype(std::declval<const LexTrieType&>().swar())
+    >> : std::true_type
+{};
+
+template <class LexTrieType>
+inline constexpr bool has_swar_v = has_swar<LexTrieType>::value;
+
+} // namespace details
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
@@ -0,0 +1,229 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <vector>
+#include <core/token.hpp>
+#include <exceptions/exceptions.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+////////////////////////////////////////////////////////////
+// TokenStream
+//
+// Every token lexed from one source buffer,
+// stored as structure-of-arrays rather than as a sequence of Token objects:
+// one symbol, one 32-bit offset and one 32-bit length per token,
+// the latter two locating the token's content within source.
+// With a 1-byte SymbolType, a token costs 9 bytes.
+//
+// Passes that only look at symbols (statistics, pre-filters)
+// can scan symbols() linearly.
+// Iterating or indexing yields TokenView objects,
+// so anything written against TokenView (e.g. Parser) consumes a stream as is.
+// Like TokenView, a stream is only valid while source is alive and unmodified.
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+struct TokenStream
+{
+    using symbol_t = SymbolType;
+    using token_view_t = TokenView<symbol_t>;
+    using offset_t = uint32_t;
+
+    struct const_iterator;
+
+    // Throws if source is too large for offset_t.
+    explicit TokenStream(std::string_view source = {});
+
+    // Appends a token whose content must either be empty or lie within source.
+    void push(symbol_t name, std::string_view content = {});
+    void push(const token_view_t& token);
+
+    // Same as push, so that a stream can be passed as a sink to LexerGeneric::tokenize.
+    void operator()(const token_view_t& token);
+
+    void reserve(size_t n);
+    void clear();
+
+    size_t size() const;
+    bool empty() const;
+    token_view_t operator[](size_t i) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    std::string_view source() const;
+    const std::vector<symbol_t>& symbols() const;
+    const std::vector<offset_t>& offsets() const;
+    const std::vector<offset_t>& lengths() const;
+
+private:
+    std::string_view source_;
+    std::vector<symbol_t> symbols_;
+    std::vector<offset_t> offsets_;     // offset of content from beginning of source_
+    std::vector<offset_t> lengths_;     // length of content
+};
+
+// Random-access iterator that yields TokenView by value.
+template <class SymbolType>
+struct TokenStream<SymbolType>::const_iterator
+{
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = token_view_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = token_view_t;
+
+    const_iterator() = default;
+    const_iterator(const TokenStream* stream, size_t i)
+        : stream_(stream), i_(i)
+    {}
+
+    reference operator*() const { return (*stream_)[i_]; }
+    reference operator[](difference_type n) const { return (*stream_)[i_ + n]; }
+
+    // symbol of current token without forming a view
+    symbol_t symbol() const { return stream_->symbols_[i_]; }
+
+    const_iterator& operator++() { ++i_; return *this; }
+    const_iterator operator++(int) { auto tmp = *this; ++i_; return tmp; }
+    const_iterator& operator--() { --i_; return *this; }
+    const_iterator operator--(int) { auto tmp = *this; --i_; return tmp; }
+    const_iterator& operator+=(difference_type n) { i_ += n; return *this; }
+    const_iterator& operator-=(difference_type n) { i_ -= n; return *this; }
+    const_iterator operator+(difference_type n) const { return const_iterator(stream_, i_ + n); }
+    const_iterator operator-(difference_type n) const { return const_iterator(stream_, i_ - n); }
+    difference_type operator-(const const_iterator& other) const
+    {
+        return static_cast<difference_type>(i_) - static_cast<difference_type>(other.i_);
+    }
+
+    bool operator==(const const_iterator& other) const { return i_ == other.i_; }
+    bool operator!=(const const_iterator& other) const { return i_ != other.i_; }
+    bool operator<(const const_iterator& other) const { return i_ < other.i_; }
+    bool operator>(const const_iterator& other) const { return i_ > other.i_; }
+    bool operator<=(const const_iterator& other) const { return i_ <= other.i_; }
+    bool operator>=(const const_iterator& other) const { return i_ >= other.i_; }
+
+private:
+    const TokenStream* stream_ = nullptr;
+    size_t i_ = 0;
+};
+
+////////////////////////////////////////////////////////////
+// TokenStream Implementation
+////////////////////////////////////////////////////////////
+
+template <class SymbolType>
+inline TokenStream<SymbolType>::TokenStream(std::string_view source)
+    : source_(source)
+{
+    if (source_.size() > std::numeric_limits<offset_t>::max()) {
+        throw exceptions::exception("source is too large to be lexed into a token stream");
+    }
+}
+
+template <class SymbolType>
+inline void TokenStream<SymbolType>::push(symbol_t name, std::string_view content)
+{
+    symbols_.push_back(name);
+    offsets_.push_back(content.empty() ? 0 :
+            static_cast<offset_t>(content.data() - source_.data()));
+    lengths_.push_back(static_cast<offset_t>(content.size()));
+}
+
+template <class SymbolType>
+inline void TokenStream<SymbolType>::push(const token_view_t& token)
+{
+    this->push(token.name, token.content);
+}
+
+template <class SymbolType>
+inline void TokenStream<SymbolType>::operator()(const token_view_t& token)
+{
+    this->push(token);
+}
+
+template <class SymbolType>
+inline void TokenStream<SymbolType>::reserve(size_t n)
+{
+    symbols_.reserve(n);
+    offsets_.reserve(n);
+    lengths_.reserve(n);
+}
+
+template <class SymbolType>
+inline void TokenStream<SymbolType>::clear()
+{
+    symbols_.clear();
+    offsets_.clear();
+    lengths_.clear();
+}
+
+template <class SymbolType>
+inline size_t TokenStream<SymbolType>::size() const
+{
+    return symbols_.size();
+}
+
+template <class SymbolType>
+inline bool TokenStream<SymbolType>::empty() const
+{
+    return symbols_.empty();
+}
+
+template <class SymbolType>
+inline typename TokenStream<SymbolType>::token_view_t
+TokenStream<SymbolType>::operator[](size_t i) const
+{
+    return token_view_t(symbols_[i], source_.substr(offsets_[i], lengths_[i]));
+}
+
+template <class SymbolType>
+inline typename TokenStream<SymbolType>::const_iterator
+TokenStream<SymbolType>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <class SymbolType>
+inline typename TokenStream<SymbolType>::const_iterator
+TokenStream<SymbolType>::end() const
+{
+    return const_iterator(this, this->size());
+}
+
+template <class SymbolType>
+inline std::string_view TokenStream<SymbolType>::source() const
+{
+    return source_;
+}
+
+template <class SymbolType>
+inline const std::vector<typename TokenStream<SymbolType>::symbol_t>&
+TokenStream<SymbolType>::symbols() const
+{
+    return symbols_;
+}
+
+template <class SymbolType>
+inline const std::vector<typename TokenStream<SymbolType>::offset_t>&
+TokenStream<SymbolType>::offsets() const
+{
+    return offsets_;
+}
+
+template <class SymbolType>
+inline const std::vector<typename TokenStream<SymbolType>::offset_t>&
+TokenStream<SymbolType>::lengths() const
+{
+    return lengths_;
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
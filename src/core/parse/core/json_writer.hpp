@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <nlohmann/json.hpp>
 
@@ -42,7 +43,7 @@ class JSONWriter {
 		 * on other state factors, such as if anything has been written to the presently handled
 		 * value and if the writer is currently in a "continuous write session".
 		 */
-		void feed(const std::string& s);
+		void feed(std::string_view s);
 
 		/*
 		 * Trims the value currently being written of any trailing whitespace,
@@ -55,7 +56,7 @@ class JSONWriter {
 		/*
 		 * Sets the JSON currently being handled (written to).
 		 */
-		void set_key(const char *key);
+		void set_key(std::string_view key);
 
 		/*
 		 * Store the current active_ JSON by moving it into destination JSON at the
@@ -208,7 +209,7 @@ inline void JSONWriter::write(char c, bool counts)
 	}
 }
 
-inline void JSONWriter::feed(const std::string& s)
+inline void JSONWriter::feed(std::string_view s)
 {
 	if (writing()){
 		if (!skipping()) {
@@ -218,11 +219,11 @@ inline void JSONWriter::feed(const std::string& s)
 					write(s);
 				}
 			}
-			else if ((start_pos = s.find_first_not_of(' ')) != std::string::npos) { // otherwise write from non-whitespace
+			else if ((start_pos = s.find_first_not_of(' ')) != std::string_view::npos) { // otherwise write from non-whitespace
 				if (written()) { // if something has already been written to the current value, separate with a space
 					write(' ');
 				}
-				write(s.c_str() + start_pos);
+				write(s.substr(start_pos));
 			}
 		}
 		to_skip_ = false;
@@ -254,7 +255,7 @@ inline void JSONWriter::cleanup_written()
 	to_pushback_ = false;
 }
 
-inline void JSONWriter::set_key(const char *key)
+inline void JSONWriter::set_key(std::string_view key)
 {
 	cleanup_written();
 	handle_pending_backout();
@@ -11,9 +11,30 @@ namespace parse {
 
 using symbol_t = Symbol;
 
-using token_t = Token<symbol_t>;
-
-using writer_t = core::JSONWriter;
+// Workers consume non-owning tokens so that tokens lexed from
+// an in-memory buffer never need to be copied.
+// Owning tokens convert implicitly.
+// A WHITESPACE or NEWLINE token may stand for a run of them (see Parser::process),
+// so workers must not count them towards tolerances or timeouts.
+using token_t = TokenView<symbol_t>;
+
+/*
+ * Destination of every worker routine: the JSON writer, along with
+ * hints to whoever feeds tokens to the parser (see Parser::skip_block_requested).
+ */
+class Writer : public core::JSONWriter
+{
+	public:
+		void request_skip_block() { skip_block_ = true; } // nothing is needed until the close brace matching the current open brace
+		bool skip_block_requested() const { return skip_block_; }
+		bool needs_text() const { return key_set() || anything_written() || !at_top(); } // content of TEXT may be written: a key is handled, or a declaration may follow what was written
+		void clear_requests() { skip_block_ = false; }
+
+	private:
+		bool skip_block_ = false;
+};
+
+using writer_t = Writer;
 
 using worker_t = core::ParseWorker<token_t, writer_t>;
 
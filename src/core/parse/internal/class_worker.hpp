@@ -54,7 +54,7 @@ class ClassWorker : public worker_t
 		};
 };
 
-const routine_details_t::routine_t ClassWorker::Routines::on_open_ = [](worker_t *worker, const token_t& token, dest_t& writer) { 
+inline const routine_details_t::routine_t ClassWorker::Routines::on_open_ = [](worker_t *worker, const token_t& token, dest_t& writer) { 
 	writer.stop_writing();
 	if (token == symbol_t::SEMICOLON) {
 		writer.store_to_pushback(CLASSES_KEY);
@@ -42,7 +42,10 @@ class FuncWorker : public worker_t
 				writer.store_to_pushback(FUNCS_KEY);
 				if (token == symbol_t::SEMICOLON) {
 					worker->restart(token, writer);
+					return;
 				}
+				/* body is ignored up to its close brace */
+				writer.request_skip_block();
 			};
 		};
 };
@@ -16,7 +16,8 @@ class TagWorker : public worker_t
 					symbol_t::SDESC,
 					symbol_t::TPARAM,
 					symbol_t::PARAM,
-					symbol_t::RETURN
+					symbol_t::RETURN,
+					symbol_t::TAG
 				}, Routines::on_tag_),
 				TokenHandler(symbol_t::TEXT, nullptr)
 			}, Routines::on_cleanup_)
@@ -27,14 +28,24 @@ class TagWorker : public worker_t
 		static constexpr const char * const PARAM_NAME_KEY = "name";
 		static constexpr const char * const PARAM_DESC_KEY = "desc";
 
+		/* built-in tags map to their name, any other tag keeps its lexeme ("@section") */
+		static std::string_view tag_name(const token_t& token)
+		{
+			std::string_view name = token.str();
+			if (!name.empty() && name.front() == '@') {
+				name.remove_prefix(1);
+			}
+			return name;
+		}
+
 		struct Routines : private routine_details_t
 		{
 			using token_t = routine_details_t::token_t;
 
-			static constexpr const routine_t on_param_first_text_  = [](worker_t *worker, const token_t& token, dest_t& writer) {
+			static constexpr const routine_t on_param_first_text_  = [](worker_t *, const token_t& token, dest_t& writer) {
 				writer.go_into_pushback(PARAMS_KEY);
 				writer.set_key(PARAM_NAME_KEY);
-				writer.write(token.c_str());
+				writer.write(token.str());
 				writer.set_key(PARAM_DESC_KEY);
 				writer.start_writing();
 				writer.skip_write();
@@ -47,7 +58,7 @@ class TagWorker : public worker_t
 					return;
 				}
 
-				writer.set_key(token.c_str());
+				writer.set_key(tag_name(token));
 				writer.start_writing();
 				writer.skip_write();
 				worker->restart(token, writer);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <initializer_list>
 #include <nlohmann/json.hpp>
 #include "core/parse/details.hpp"
@@ -13,20 +14,77 @@ namespace parse {
 class Parser
 {
 	public:
+		/*
+		 * Processes a single token. Token content is only read during this call
+		 * (anything needed is copied into the parsed JSON), so token may
+		 * refer to a buffer that is released afterwards.
+		 * WHITESPACE and NEWLINE tokens may each stand for a run of them
+		 * (see LexerGeneric::coalesce), with the run as content:
+		 * output is the same as if the run was processed token by token.
+		 */
 		void process(const token_t& token);
 
+		/*
+		 * Returns true if the last token processed opened a block
+		 * (e.g. a function body) of which only the matching close brace matters,
+		 * in which case the lexer may skip straight to it (see LexerGeneric::skip_block).
+		 */
+		bool skip_block_requested() const { return writer_.skip_block_requested(); }
+
+		/*
+		 * Returns true if content of the next TEXT token may be read.
+		 * Otherwise (e.g. in code that follows no documentation),
+		 * only the presence of TEXT tokens matters and the lexer
+		 * need not build their content (see LexerGeneric::want_text).
+		 */
+		bool needs_text() const { return writer_.needs_text(); }
+
+		/*
+		 * Discards everything parsed along with any state left by the last input,
+		 * so that the parser may be reused on another input (see Session).
+		 */
+		void reset();
+
 		nlohmann::json& parsed() { return writer_.stored(); }
 		const nlohmann::json& parsed() const { return writer_.stored(); }
 
 	private:	
-		worker_t worker_ = internal::GeneralWorker().inject_worker_at(0, internal::ClassWorker());
+		static worker_t make_worker_() { return internal::GeneralWorker().inject_worker_at(0, internal::ClassWorker()); }
+
+		worker_t worker_ = make_worker_();
 		writer_t writer_;
 };
 
 inline void Parser::process(const token_t& token)
 {
+	writer_.clear_requests();
 	worker_.proc(token, writer_);
-	writer_.feed(token.c_str());
+
+	if (!coalesces(token.name)) {
+		writer_.feed(token.str());
+		return;
+	}
+
+	/*
+	 * a coalesced run is fed as its single-char tokens would be:
+	 * one space per whitespace char and nothing per newline (not its raw content)
+	 */
+	const std::string_view single = token_t(token.name).str();
+	size_t n = 1;
+	if (!single.empty() && writer_.writing()) {
+		n = std::max<size_t>(token.content.size(), 1);
+	}
+	for (size_t i = 0; i < n; ++i) {
+		writer_.feed(single);
+	}
+}
+
+inline void Parser::reset()
+{
+	/* assigning from a pristine copy reuses the storage of every worker, unlike building them anew */
+	static const worker_t pristine = make_worker_();
+	worker_ = pristine;
+	writer_.reset();
 }
 
 } // namespace parse
@@ -1,10 +1,12 @@
 #pragma once
+#include <cstdint>
 #include <mapbox/eternal.hpp>
 
 namespace docgen {
 namespace core {
 
-enum class Symbol {
+// Stored in a single byte to keep token streams compact.
+enum class Symbol : uint8_t {
     // single-char tokens
     END_OF_FILE,
     NEWLINE,
@@ -32,6 +34,8 @@ enum class Symbol {
     TPARAM,
     PARAM,
     RETURN,
+    // any other tag (e.g. "@section"), content holds the lexeme
+    TAG,
     // default
     TEXT
 };
@@ -62,5 +66,49 @@ static MAPBOX_ETERNAL_CONSTEXPR const auto symbol_map =
             {Symbol::RETURN, "return"},
     });
 
+// Returns true if tokens of symbol s carry the matched lexeme as content
+// (by default, symbol tokens have empty content).
+template <class SymbolType>
+inline constexpr bool keeps_lexeme(SymbolType)
+{
+    return false;
+}
+
+template <>
+inline constexpr bool keeps_lexeme<Symbol>(Symbol s)
+{
+    return s == Symbol::TAG;
+}
+
+// Returns true if consecutive tokens of symbol s may be coalesced into one
+// whose content holds every lexeme of the run (see LexerGeneric::coalesce).
+template <class SymbolType>
+inline constexpr bool coalesces(SymbolType)
+{
+    return false;
+}
+
+template <>
+inline constexpr bool coalesces<Symbol>(Symbol s)
+{
+    return s == Symbol::WHITESPACE || s == Symbol::NEWLINE;
+}
+
+// Symbols of braces that delimit blocks the lexer can skip
+// (see LexerGeneric::skip_block). Disabled by default.
+template <class SymbolType>
+struct block_symbols
+{
+    static constexpr bool enabled = false;
+};
+
+template <>
+struct block_symbols<Symbol>
+{
+    static constexpr bool enabled = true;
+    static constexpr Symbol open = Symbol::OPEN_BRACE;
+    static constexpr Symbol close = Symbol::CLOSE_BRACE;
+};
+
 } // namespace core
 } // namespace docgen
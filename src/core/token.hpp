@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <core/symbol.hpp>
 
 namespace docgen {
@@ -41,6 +42,50 @@ inline bool operator!=(const Token<Symbol>& t1, const Token<Symbol>& t2) {
 	return !(t1 == t2);
 }
 
+// Non-owning counterpart of Token.
+// content refers into the buffer the token was lexed from (or into the content
+// of the Token it was constructed from), so a TokenView is only valid
+// for as long as that buffer is alive and unmodified.
+template <class SymbolType>
+struct TokenView
+{
+    using symbol_t = SymbolType;
+
+    TokenView(symbol_t name, std::string_view content)
+        : name(name)
+        , content(content)
+    {}
+
+    TokenView(symbol_t name)
+        : TokenView(name, std::string_view())
+    {}
+
+    TokenView(const Token<symbol_t>& token)
+        : TokenView(token.name, token.content)
+    {}
+
+    // left undefined for SymbolType != Symbol
+    std::string_view str() const;
+
+    symbol_t name;
+    std::string_view content;
+};
+
+template <>
+inline std::string_view TokenView<Symbol>::str() const
+{
+    return (symbol_map.find(name) != symbol_map.end()) ?
+        std::string_view(symbol_map.at(name).c_str()) : content;
+}
+
+inline bool operator==(const TokenView<Symbol>& t1, const TokenView<Symbol>& t2) {
+	return t1.name == t2.name;
+}
+
+inline bool operator!=(const TokenView<Symbol>& t1, const TokenView<Symbol>& t2) {
+	return !(t1 == t2);
+}
+
 } // namespace core
 } // namespace docgen
 
@@ -55,4 +100,13 @@ struct hash<docgen::core::Token<docgen::core::Symbol>>
 	}
 };
 
+template <>
+struct hash<docgen::core::TokenView<docgen::core::Symbol>>
+{
+	size_t operator()(const docgen::core::TokenView<docgen::core::Symbol>& t) const
+	{
+		return hash<size_t>()(static_cast<size_t>(t.name));
+	}
+};
+
 } // namespace std
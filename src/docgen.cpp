@@ -1,16 +1,25 @@
 #include <getopt.h>
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
 #include <cctype>
 #include <cstring>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <vector>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <thread>
 #include <nlohmann/json.hpp>
 #include "exceptions/exceptions.hpp"
+#include "io/dir_walker.hpp"
+#include "io/path_filter.hpp"
+#include "manifest.hpp"
 #include "parse_file.hpp"
+#include "result_cache.hpp"
 
 using namespace docgen;
 
@@ -20,22 +29,46 @@ static constexpr const char * const SRC_PATH_DEFAULT = ".";
 static constexpr const char * const DOCS_DST_PATH_DEFAULT = ".";
 static constexpr std::ostream * const LOG_STREAM_DEFAULT = &std::cerr;
 static constexpr std::ostream * const ERR_STREAM_DEFAULT = &std::cerr;
+static constexpr size_t JOBS_DEFAULT = 1;
+static constexpr size_t PREFETCH_DEFAULT = 0;
+static constexpr bool PREFILTER_DEFAULT = false; // prefiltering drops undocumented template classes from output
+static constexpr const char * const MANIFEST_SUFFIX = ".manifest"; // manifest is kept next to output file by default
+static constexpr uintmax_t CACHE_MAX_SIZE_DEFAULT = 256 << 20;
 
 /* Configuration JSON keys */
 static constexpr const char * const SOURCE_FILES_KEY = "source";
 static constexpr const char * const EXCLUDE_FILES_KEY = "exclude";
+static constexpr const char * const INCLUDE_PATTERNS_KEY = "include";
 static constexpr const char * const LOG_FILE_KEY = "logfile";
 static constexpr const char * const ERR_FILE_KEY = "errfile";
+static constexpr const char * const TAGS_KEY = "tags";
+static constexpr const char * const JOBS_KEY = "jobs";
+static constexpr const char * const PREFETCH_KEY = "prefetch";
+static constexpr const char * const PREFILTER_KEY = "prefilter";
+static constexpr const char * const MANIFEST_KEY = "manifest";
+static constexpr const char * const CACHE_KEY = "cache";
+static constexpr const char * const CACHE_MAX_SIZE_KEY = "cache_max_size";
 
 /* Options */
 static nlohmann::json config;
 static std::vector<std::string> file_source_paths;
 static std::unordered_set<std::string> file_source_excludes;
+static std::vector<std::string> file_source_patterns; // see io::PathFilter
+static std::optional<io::PathFilter> file_source_filter;
 static std::shared_ptr<std::istream> parsed_src(nullptr);
 static std::shared_ptr<std::ostream> parsed_dst(nullptr);
 static std::shared_ptr<std::ostream> logger(LOG_STREAM_DEFAULT, [](std::ostream *){});
 static std::shared_ptr<std::ostream> err(ERR_STREAM_DEFAULT, [](std::ostream *){});
 static const char *docs_dst_path = DOCS_DST_PATH_DEFAULT;
+static core::lex::modal_lextable_t lextable;
+static size_t jobs = 0; // 0 until set, then the number of threads parsing files
+static std::optional<size_t> prefetch; // number of files read ahead of those being parsed (see io::Prefetcher)
+static std::optional<bool> prefilter; // skip files without doc comments, dropping undocumented template classes (see Session::prefilter)
+static std::string parsed_dst_path; // set if output is a file
+static std::string manifest_path; // incremental parsing is on if set (see Manifest)
+static std::string cache_path; // results are shared through a ResultCache in this directory if set
+static uintmax_t cache_max_size = CACHE_MAX_SIZE_DEFAULT;
+static nlohmann::json parse_key; // whatever parsing depends on besides the docgen version
 
 /*
  * set_options() helper for opening output file stream and error-checking
@@ -56,6 +89,21 @@ static inline void set_option_outfile_append_stream(std::shared_ptr<std::ostream
 	set_option_outfile_stream(stream, path, true);
 }
 
+/*
+ * set_options() helper for parsing a number of jobs; 0 stands for every hardware thread
+ */
+static inline size_t set_option_jobs(long n)
+{
+	if (n < 0) {
+		fprintf(stderr, "Number of jobs must not be negative.\n");
+		throw exceptions::bad_flags();
+	}
+	if (n == 0) {
+		return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	}
+	return n;
+}
+
 /*
  * Sets global options as per passed argv and docgen configuration file (if present)
  */
@@ -63,7 +111,7 @@ static inline void set_options(int argc, char **argv)
 {
 	// set by flags
 	int c;
-	while ((c = getopt(argc, argv, ":c:i:o:l:e:x:d:")) != -1) {
+	while ((c = getopt(argc, argv, ":c:i:o:l:e:x:g:d:j:p:fm:C:")) != -1) {
 		switch (c) {
 			case 'c':
 				if (strcmp(optarg, "-") == 0) {
@@ -98,6 +146,7 @@ static inline void set_options(int argc, char **argv)
 				}
 				else {
 					set_option_outfile_stream(parsed_dst, optarg);
+					parsed_dst_path = optarg;
 				}
 				break;
 			case 'l':
@@ -110,6 +159,9 @@ static inline void set_options(int argc, char **argv)
 			case 'x':
 				file_source_excludes.insert(std::filesystem::weakly_canonical(optarg));
 				break;
+			case 'g':
+				file_source_patterns.push_back(optarg);
+				break;
 			case 'd':
 			{
 				size_t arg_len = strlen(optarg);
@@ -119,6 +171,37 @@ static inline void set_options(int argc, char **argv)
 				docs_dst_path = optarg;
 				break;
 			}
+			case 'm':
+				manifest_path = optarg;
+				break;
+			case 'C':
+				cache_path = optarg;
+				break;
+			case 'j':
+			{
+				char *end;
+				long n = strtol(optarg, &end, 10);
+				if (*optarg == 0 || *end != 0) {
+					fprintf(stderr, "Option -j requires a number.\n");
+					throw exceptions::bad_flags();
+				}
+				jobs = set_option_jobs(n);
+				break;
+			}
+			case 'p':
+			{
+				char *end;
+				long n = strtol(optarg, &end, 10);
+				if (*optarg == 0 || *end != 0 || n < 0) {
+					fprintf(stderr, "Option -p requires a number of files.\n");
+					throw exceptions::bad_flags();
+				}
+				prefetch = n;
+				break;
+			}
+			case 'f':
+				prefilter = true;
+				break;
 			case ':':
 				fprintf(stderr, "Option -%c requires an argument.\n", optopt);
 				throw exceptions::bad_flags();
@@ -158,8 +241,16 @@ static inline void set_options(int argc, char **argv)
 	// set by information from config json if present
 	nlohmann::json& config_source = config[SOURCE_FILES_KEY];
 	nlohmann::json& config_exclude = config[EXCLUDE_FILES_KEY];
+	nlohmann::json& config_include = config[INCLUDE_PATTERNS_KEY];
 	nlohmann::json& config_logfile = config[LOG_FILE_KEY];
 	nlohmann::json& config_errfile = config[ERR_FILE_KEY];
+	nlohmann::json& config_tags = config[TAGS_KEY];
+	nlohmann::json& config_jobs = config[JOBS_KEY];
+	nlohmann::json& config_prefetch = config[PREFETCH_KEY];
+	nlohmann::json& config_prefilter = config[PREFILTER_KEY];
+	nlohmann::json& config_manifest = config[MANIFEST_KEY];
+	nlohmann::json& config_cache = config[CACHE_KEY];
+	nlohmann::json& config_cache_max_size = config[CACHE_MAX_SIZE_KEY];
 	std::string *val_ptr;
 
 	file_source_count += config_source.size();
@@ -180,6 +271,60 @@ static inline void set_options(int argc, char **argv)
 		}
 	}
 
+	// patterns from config come first, then those from flags
+	if (config_include.is_array()) {
+		std::vector<std::string> patterns;
+		for (nlohmann::json& val : config_include) {
+			if ((val_ptr = val.get_ptr<std::string *>())) {
+				patterns.push_back(std::move(*val_ptr));
+			}
+		}
+		file_source_patterns.insert(file_source_patterns.begin(), patterns.begin(), patterns.end());
+	}
+	file_source_filter.emplace(file_source_patterns);
+
+	// build lexer table once with any project-specific tags
+	std::vector<std::string> tags;
+	if (config_tags.is_array()) {
+		for (nlohmann::json& val : config_tags) {
+			if ((val_ptr = val.get_ptr<std::string *>())) {
+				tags.push_back(std::move(*val_ptr));
+			}
+		}
+	}
+	parse_key = { {TAGS_KEY, tags} };
+	lextable = core::lex::make_modal_lextable(tags);
+
+	if (manifest_path.empty()) {
+		if (config_manifest.is_string()) {
+			manifest_path = config_manifest.get<std::string>();
+		}
+		else if (!parsed_dst_path.empty()) {
+			manifest_path = parsed_dst_path + MANIFEST_SUFFIX;
+		}
+	}
+
+	if (cache_path.empty() && config_cache.is_string()) {
+		cache_path = config_cache.get<std::string>();
+	}
+	if (config_cache_max_size.is_number_unsigned()) {
+		cache_max_size = config_cache_max_size.get<uintmax_t>();
+	}
+
+	if (jobs == 0) {
+		jobs = config_jobs.is_number_integer() ? set_option_jobs(config_jobs.get<long>()) : JOBS_DEFAULT;
+	}
+	if (!prefetch) {
+		prefetch = config_prefetch.is_number_unsigned() ? config_prefetch.get<size_t>() : PREFETCH_DEFAULT;
+	}
+	if (!prefilter) {
+		prefilter = config_prefilter.is_boolean() ? config_prefilter.get<bool>() : PREFILTER_DEFAULT;
+	}
+	// files without doc comments then have no results, so those must not be reused without the prefilter
+	if (*prefilter) {
+		parse_key[PREFILTER_KEY] = true;
+	}
+
 	if (config_logfile.is_string() && logger.get() == LOG_STREAM_DEFAULT) {
 		set_option_outfile_append_stream(logger, config_logfile.get_ref<std::string&>().c_str());
 	}
@@ -198,6 +343,64 @@ static inline void set_options(int argc, char **argv)
 /* Parsing data JSON */
 static nlohmann::json parsed;
 
+/*
+ * to_parsed() helper going through directory at path as walked by io::walk_dir,
+ * in the order of a recursive_directory_iterator (every directory followed by its contents),
+ * and gathering every file to parse along with its stat
+ */
+static void gather_dir(const io::WalkedDir& dir, const std::string& path, const std::filesystem::path& cwd,
+                       std::unordered_set<std::string>& processed,
+                       std::vector<std::string>& files, std::vector<io::FileStat>& stats)
+{
+	namespace fs = std::filesystem;
+
+	if (dir.error) {
+		throw exceptions::system_error("failed to read directory at path \"" + path + '\"', dir.error);
+	}
+
+	for (const io::WalkedEntry& entry : dir.entries) {
+		std::string entry_path = io::walked_path(path, entry.name);
+
+		// skip whatever include patterns leave out (walk_dir did not list a directory that is)
+		if (entry.filtered) {
+			if (entry.kind == io::EntryKind::DIRECTORY) {
+				*logger << "Excluding " << fs::path(entry_path) << " (filtered out)" << '\n';
+			}
+			continue;
+		}
+
+		// skip path within directory if it's already been processed
+		// (whatever is in it is still gone through)
+		// only paths through symlinks need to be canonicalized (as walk_dir did)
+		if (processed.find(entry_path) == processed.end()) {
+			const std::string& canonical_path = entry.target.empty() ? entry_path : entry.target;
+			processed.insert(canonical_path);
+
+			// skip path if excluded by user (walk_dir did not list a directory that is)
+			if (file_source_excludes.find(entry_path) != file_source_excludes.end()) {
+				*logger << "Excluding " << fs::path(entry_path) << '\n';
+				continue;
+			}
+
+			// handle by file if regular or not
+			if (entry.kind == io::EntryKind::FILE) {
+				// parse regular file
+				*logger << "Parsing " << fs::path(entry_path) << '\n';
+				files.push_back(fs::path(canonical_path).lexically_relative(cwd));
+				stats.push_back(entry.stat);
+			}
+			else if (entry.kind != io::EntryKind::DIRECTORY) {
+				// skip irregular file
+				*logger << "Skipping " << fs::path(entry_path) << " (not regular file)" << '\n';
+			}
+		}
+
+		if (entry.dir) {
+			gather_dir(*entry.dir, entry_path, cwd, processed, files, stats);
+		}
+	}
+}
+
 /*
  * Populates global JSON with parsing data as per global options
  */
@@ -213,9 +416,13 @@ static inline void to_parsed()
 	}
 
 	namespace fs = std::filesystem;
-	using dir_iterator_t = fs::recursive_directory_iterator;
 
 	std::unordered_set<std::string> processed;
+	const fs::path cwd = fs::weakly_canonical(fs::current_path());
+
+	// files are gathered in order here and parsed all at once (in parallel) afterwards
+	std::vector<std::string> files;
+	std::vector<io::FileStat> stats;
 
 	// iterate over paths specified by user
 	fs::path src_path;
@@ -231,39 +438,17 @@ static inline void to_parsed()
 		if (fs::is_regular_file(src_path)) {
 			// parse regular files
 			*logger << "Parsing " << src_path << '\n';
-			parse_file(fs::relative(src_path).c_str(), parsed);
+			files.push_back(fs::relative(src_path));
+			io::FileStat stat;
+			if (!io::stat_file(src_path.c_str(), stat)) {
+				throw exceptions::system_error("failed to stat file at path \"" + src_path.string() + '\"');
+			}
+			stats.push_back(stat);
 		}
 		else if (fs::is_directory(src_path)) {
-			// recursively iterate through directory
-			for (dir_iterator_t it = dir_iterator_t(src_path); it != dir_iterator_t(); ++it) {
-				const fs::directory_entry& entry = *it;
-
-				// skip path within directory if it's already been processed
-				if (processed.find(entry.path()) != processed.end()) {
-					continue;
-				}
-				processed.insert(fs::weakly_canonical(entry.path()));
-
-				// skip path if excluded by user
-				if (file_source_excludes.find(entry.path()) != file_source_excludes.end()) {
-					*logger << "Excluding " << entry.path() << '\n';
-					if (entry.is_directory()) {
-						it.disable_recursion_pending();
-					}
-					continue;
-				}
-				
-				// handle by file if regular or not
-				if (entry.is_regular_file()) {
-					// parse regular file
-					*logger << "Parsing " << entry.path() << '\n';
-					parse_file(fs::relative(entry.path()).c_str(), parsed);
-				}
-				else if (!entry.is_directory()) {
-					// skip irregular file
-					*logger << "Skipping " << entry.path() << " (not regular file)" << '\n';
-				}
-			}
+			// list the whole directory tree at once (in parallel), then go through it in order
+			io::WalkedDir dir = io::walk_dir(src_path, file_source_excludes, jobs, &*file_source_filter);
+			gather_dir(dir, src_path, cwd, processed, files, stats);
 		}
 		else if (!fs::exists(src_path)) {
 			throw exceptions::file_exist_error(src_path);
@@ -272,6 +457,64 @@ static inline void to_parsed()
 			throw exceptions::bad_file(src_path);
 		}
 	}
+
+	ParseStats parse_stats;
+	ParseOptions options(jobs);
+	options.prefetch = *prefetch;
+	options.prefilter = *prefilter;
+	options.stats = &parse_stats;
+
+	std::optional<ResultCache> cache;
+	if (!cache_path.empty()) {
+		cache.emplace(cache_path, parse_key, cache_max_size);
+	}
+
+	// parse only what changed since the manifest was last saved if there is one
+	if (!manifest_path.empty()) {
+		Manifest manifest(manifest_path, parse_key);
+		size_t n = manifest.parse(files, stats, parsed, lextable, options, cache ? &*cache : nullptr);
+		*logger << "Parsed " << n << " of " << files.size() << " files (rest unchanged since last run)" << '\n';
+		manifest.save();
+	}
+	else {
+		std::vector<uintmax_t> sizes;
+		sizes.reserve(stats.size());
+		for (const io::FileStat& stat : stats) {
+			sizes.push_back(stat.size);
+		}
+		if (cache) {
+			std::vector<std::optional<uint64_t>> hashes(files.size());
+			for (nlohmann::json& result : cache->parse_each(files, sizes, hashes, lextable, options)) {
+				if (!result.is_null()) {
+					parsed.push_back(std::move(result));
+				}
+			}
+		}
+		else {
+			parse_files(files, sizes, parsed, lextable, options);
+		}
+	}
+
+	*logger << "Waited " << std::chrono::duration_cast<std::chrono::milliseconds>(parse_stats.input_wait).count()
+	        << "ms for " << parse_stats.files << " files to be read" << '\n';
+	for (const std::string& path : parse_stats.binary) {
+		*logger << "Skipping " << fs::absolute(path) << " (binary)" << '\n';
+	}
+	// files whose result is reused are not read again, so are not counted here (see ParseStats)
+	*logger << "Skipped " << parse_stats.binary.size() << " binary files of " << parse_stats.files
+	        << " read this run" << '\n';
+	if (*prefilter) {
+		*logger << "Skipped " << parse_stats.skipped << " of " << parse_stats.files
+		        << " files read this run without doc comments" << '\n';
+	}
+
+	if (cache) {
+		*logger << "Took " << cache->hits() << " results from cache" << '\n';
+		size_t evicted = cache->evict();
+		if (evicted) {
+			*logger << "Evicted " << evicted << " results from cache" << '\n';
+		}
+	}
 }
 
 /*
@@ -90,5 +90,13 @@ class bad_flags : public exception
 		{}
 };
 
+class bad_glob : public exception
+{
+	public:
+		bad_glob(const std::string& pattern, const std::string& reason) noexcept
+			: exception("bad glob pattern \"" + pattern + "\": " + reason)
+		{}
+};
+
 } // namespace exceptions
 } // namespace docgen
@@ -0,0 +1,221 @@
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include "parallel.hpp"
+#include "io/dir_walker.hpp"
+
+namespace docgen {
+namespace io {
+
+/*
+ * Directory kept open for as long as any of its subdirectories is yet to be opened
+ * relative to it (i.e. as long as a walk job refers to it).
+ */
+class OpenDir
+{
+	public:
+		explicit OpenDir(DIR *dir) : dir_(dir) {}
+		OpenDir(const OpenDir&) = delete;
+		OpenDir& operator=(const OpenDir&) = delete;
+		~OpenDir() { closedir(dir_); }
+
+		int fd() const { return dirfd(dir_); }
+
+	private:
+		DIR *dir_;
+};
+
+/*
+ * Directory to be listed into dir: entry name of parent,
+ * or path itself if it has no parent (the directory walk_dir started at).
+ */
+struct WalkJob
+{
+	std::shared_ptr<OpenDir> parent;
+	std::string name;
+	std::string path;
+	WalkedDir *dir;
+	PathFilter::state_t state; // of path (if walking with a filter)
+};
+
+std::string walked_path(const std::string& dir_path, const std::string& name)
+{
+	if (!dir_path.empty() && dir_path.back() == '/') {
+		return dir_path + name;
+	}
+	return dir_path + '/' + name;
+}
+
+/*
+ * Modification time of st in nanoseconds (macOS names the field differently).
+ */
+static inline int64_t mtime_ns(const struct stat& st)
+{
+#ifdef __APPLE__
+	const struct timespec& mtime = st.st_mtimespec;
+#else
+	const struct timespec& mtime = st.st_mtim;
+#endif
+	return static_cast<int64_t>(mtime.tv_sec) * 1000000000 + mtime.tv_nsec;
+}
+
+static inline FileStat to_file_stat(const struct stat& st)
+{
+	FileStat stat;
+	stat.size = st.st_size;
+	stat.mtime = mtime_ns(st);
+	stat.inode = st.st_ino;
+	return stat;
+}
+
+bool stat_file(const char *path, FileStat& stat)
+{
+	struct stat st;
+	if (::stat(path, &st) != 0) {
+		return false;
+	}
+	stat = to_file_stat(st);
+	return true;
+}
+
+/*
+ * Sets kind (and stat) of entry from what stat of it reports.
+ */
+static inline void set_kind(WalkedEntry& entry, const struct stat& st)
+{
+	if (S_ISREG(st.st_mode)) {
+		entry.kind = EntryKind::FILE;
+		entry.stat = to_file_stat(st);
+	}
+	else if (S_ISDIR(st.st_mode)) {
+		entry.kind = EntryKind::DIRECTORY;
+	}
+	else {
+		entry.kind = EntryKind::OTHER;
+	}
+}
+
+/*
+ * Resolves a symlink: its canonical target and what the target is.
+ * A broken symlink is left as OTHER with no target.
+ */
+static inline void resolve_symlink(int fd, const std::string& path, WalkedEntry& entry)
+{
+	entry.symlink = true;
+	struct stat st;
+	if (fstatat(fd, entry.name.c_str(), &st, 0) != 0) {
+		return;
+	}
+	char resolved[PATH_MAX];
+	if (realpath(path.c_str(), resolved) == nullptr) {
+		return;
+	}
+	entry.target = resolved;
+	set_kind(entry, st);
+}
+
+bool classify_entry(int fd, const std::string& path, unsigned char d_type, WalkedEntry& entry)
+{
+	struct stat st;
+	switch (d_type) {
+		case DT_DIR:
+			entry.kind = EntryKind::DIRECTORY;
+			return true;
+		case DT_REG:
+			entry.kind = EntryKind::FILE;
+			if (fstatat(fd, entry.name.c_str(), &st, AT_SYMLINK_NOFOLLOW) == 0) {
+				entry.stat = to_file_stat(st);
+			}
+			return false;
+		case DT_LNK:
+			resolve_symlink(fd, path, entry);
+			return false;
+		case DT_UNKNOWN:
+			// some filesystems leave it to stat
+			if (fstatat(fd, entry.name.c_str(), &st, AT_SYMLINK_NOFOLLOW) != 0) {
+				return false;
+			}
+			if (S_ISLNK(st.st_mode)) {
+				resolve_symlink(fd, path, entry);
+				return false;
+			}
+			set_kind(entry, st);
+			return entry.kind == EntryKind::DIRECTORY;
+		default:
+			entry.kind = EntryKind::OTHER;
+			return false;
+	}
+}
+
+WalkedDir walk_dir(const std::string& path, const std::unordered_set<std::string>& excludes, size_t jobs,
+                   const PathFilter *filter)
+{
+	WalkedDir root;
+	if (filter && filter->empty()) {
+		filter = nullptr;
+	}
+
+	WalkJob first{nullptr, "", path, &root, filter ? filter->root() : PathFilter::state_t()};
+	parallel::for_each_spawning(std::move(first), jobs, [&excludes, filter](WalkJob&& job, size_t, auto& spawn) {
+		// open relative to parent (which is closed once every subdirectory is open)
+		int fd = job.parent ?
+			openat(job.parent->fd(), job.name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC) :
+			open(job.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		job.parent.reset();
+		if (fd < 0) {
+			job.dir->error = errno;
+			return;
+		}
+		DIR *dir = fdopendir(fd);
+		if (dir == nullptr) {
+			job.dir->error = errno;
+			close(fd);
+			return;
+		}
+		auto open_dir = std::make_shared<OpenDir>(dir);
+
+		while (true) {
+			errno = 0;
+			struct dirent *ent = readdir(dir);
+			if (ent == nullptr) {
+				job.dir->error = errno;
+				break;
+			}
+			if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) {
+				continue;
+			}
+			WalkedEntry& entry = job.dir->entries.emplace_back();
+			entry.name = ent->d_name;
+			PathFilter::state_t state;
+			if (filter) {
+				state = filter->step(job.state, entry.name);
+				// a regular file left out is not even stat'ed
+				if (ent->d_type == DT_REG && !filter->includes(state)) {
+					entry.kind = EntryKind::FILE;
+					entry.filtered = true;
+					continue;
+				}
+			}
+			std::string entry_path = walked_path(job.path, entry.name);
+			const bool subdir = classify_entry(fd, entry_path, ent->d_type, entry);
+			if (filter) {
+				entry.filtered = entry.kind == EntryKind::DIRECTORY ? filter->prunes(state) :
+				                 entry.kind == EntryKind::FILE && !filter->includes(state);
+			}
+			if (subdir && !entry.filtered && excludes.find(entry_path) == excludes.end()) {
+				entry.dir = std::make_unique<WalkedDir>();
+				spawn(WalkJob{open_dir, entry.name, std::move(entry_path), entry.dir.get(), std::move(state)});
+			}
+		}
+	});
+
+	return root;
+}
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "io/path_filter.hpp"
+
+namespace docgen {
+namespace io {
+
+/*
+ * What a directory entry refers to, symlinks being followed.
+ */
+enum class EntryKind {
+	FILE, // regular file
+	DIRECTORY,
+	OTHER // anything else, including a broken symlink
+};
+
+/*
+ * What stat reports of a regular file, as far as telling whether it changed goes.
+ */
+struct FileStat
+{
+	uintmax_t size = 0;
+	int64_t mtime = 0; // modification time in nanoseconds
+	uintmax_t inode = 0;
+
+	bool operator==(const FileStat& other) const
+	{
+		return size == other.size && mtime == other.mtime && inode == other.inode;
+	}
+};
+
+/*
+ * Stats file at path, following symlinks. Returns false (with errno set) on failure.
+ */
+bool stat_file(const char *path, FileStat& stat);
+
+struct WalkedDir;
+
+/*
+ * Entry of a walked directory, as listed by readdir (without "." and "..").
+ */
+struct WalkedEntry
+{
+	std::string name;
+	EntryKind kind = EntryKind::OTHER;
+	FileStat stat; // of a FILE
+	bool symlink = false;
+	std::string target; // canonical path of what a symlink refers to (empty if broken)
+	std::unique_ptr<WalkedDir> dir; // contents of a DIRECTORY that is no symlink, unless excluded
+	bool filtered = false; // left out by the PathFilter (a FILE is then not stat'ed, a DIRECTORY not listed)
+};
+
+/*
+ * Contents of a walked directory, in the order readdir listed them.
+ */
+struct WalkedDir
+{
+	std::vector<WalkedEntry> entries;
+	int error = 0; // errno if directory could not be listed
+};
+
+/*
+ * Lists directory at path along with every subdirectory, recursively, on jobs threads.
+ * Subdirectories are opened relative to their parent (openat) and classified by
+ * the type readdir reports; the only other syscalls are an fstatat per regular file
+ * (for its FileStat) and per entry of unknown type, and a realpath per symlink.
+ * Symlinks are not followed into, and subdirectories whose path
+ * (path, '/' and the names of the entries leading to it) is in excludes are not listed.
+ * If filter is set, it is matched against paths relative to path as the walk goes,
+ * and entries it leaves out are marked filtered (see WalkedEntry).
+ * path should be canonical for paths of subdirectories to be.
+ */
+WalkedDir walk_dir(const std::string& path, const std::unordered_set<std::string>& excludes, size_t jobs,
+                   const PathFilter *filter = nullptr);
+
+/*
+ * Classifies entry (of which only name is set) of directory fd, entry path being path,
+ * by d_type as readdir reports it, stat'ing it only if d_type does not tell
+ * (DT_UNKNOWN, which some filesystems always report) or to stat a FILE.
+ * Returns true if it is a subdirectory to be listed (i.e. no symlink).
+ */
+bool classify_entry(int fd, const std::string& path, unsigned char d_type, WalkedEntry& entry);
+
+/*
+ * Returns path of entry name within directory at path dir_path, as walk_dir builds it.
+ */
+std::string walked_path(const std::string& dir_path, const std::string& name);
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,13 @@
+#include "io/file_hash.hpp"
+#include "io/mapped_file.hpp"
+
+namespace docgen {
+namespace io {
+
+uint64_t hash_file(const char *path)
+{
+	return hash_bytes(MappedFile(path).view());
+}
+
+} // namespace io
+} // namespace docgen
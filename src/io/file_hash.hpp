@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace docgen {
+namespace io {
+
+/* Seed of a hash of no bytes at all */
+static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325;
+
+/*
+ * Continues hash (64-bit FNV-1a) with bytes.
+ * Stable across platforms and builds, so hashes may be kept in files.
+ */
+inline uint64_t hash_bytes(std::string_view bytes, uint64_t hash = HASH_SEED)
+{
+	for (char c : bytes) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+/*
+ * Returns hash_bytes of the content of file at path, or throws if it cannot be read.
+ */
+uint64_t hash_file(const char *path);
+
+} // namespace io
+} // namespace docgen
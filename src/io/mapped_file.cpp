@@ -0,0 +1,126 @@
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <string>
+#include <utility>
+#include "exceptions/exceptions.hpp"
+#include "io/mapped_file.hpp"
+
+#define PIPE_BUF_SZ 65536
+
+namespace docgen {
+namespace io {
+
+/*
+ * Closes fd on scope exit.
+ */
+struct FdCloser
+{
+	int fd;
+	~FdCloser() { close(fd); }
+};
+
+MappedFile::MappedFile(const char *path)
+{
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		throw exceptions::file_open_error(path);
+	}
+	FdCloser closer{fd};
+
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		throw exceptions::system_error("fstat() failed on file at path \"" + std::string(path) + '\"');
+	}
+	const bool regular = S_ISREG(st.st_mode);
+
+	if (regular && static_cast<size_t>(st.st_size) >= MAP_MIN_SIZE) {
+		// pages are read in as they are first accessed, the kernel reading ahead of them
+		void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map != MAP_FAILED) {
+			map_ = map;
+			map_size_ = st.st_size;
+			madvise(map_, map_size_, MADV_SEQUENTIAL);
+			view_ = std::string_view(static_cast<const char *>(map_), map_size_);
+			return;
+		}
+		// e.g. a file system that does not support mapping: read instead
+	}
+
+	// read regular files at once (with room for one more byte to notice a file that grew),
+	// anything else until its end
+	buf_.resize(regular ? st.st_size + 1 : PIPE_BUF_SZ);
+	size_t n = 0;
+	for (;;) {
+		if (n == buf_.size()) {
+			buf_.resize(2 * buf_.size());
+		}
+		ssize_t r = read(fd, buf_.data() + n, buf_.size() - n);
+		if (r < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw exceptions::system_error("read() failed on file at path \"" + std::string(path) + '\"');
+		}
+		n += r;
+		// a regular file only reads short at its end
+		if (r == 0 || (regular && n < buf_.size())) {
+			break;
+		}
+	}
+	buf_.resize(n);
+	view_ = buf_;
+}
+
+void MappedFile::touch(size_t offset, size_t size) const
+{
+	if (!map_ || offset >= map_size_) {
+		return;
+	}
+	static const size_t page_size = sysconf(_SC_PAGESIZE);
+	const volatile char *data = static_cast<const char *>(map_);
+	const size_t end = std::min(offset + size, map_size_);
+	for (size_t i = offset; i < end; i += page_size) {
+		data[i];
+	}
+	data[end - 1];
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other) {
+		unmap_();
+		map_ = std::exchange(other.map_, nullptr);
+		map_size_ = std::exchange(other.map_size_, 0);
+		buf_ = std::move(other.buf_);
+		// a short buf_ is copied rather than moved, so its view is taken again
+		view_ = map_ ? other.view_ : std::string_view(buf_);
+		other.view_ = std::string_view();
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	unmap_();
+}
+
+void MappedFile::unmap_()
+{
+	if (map_) {
+		munmap(map_, map_size_);
+		map_ = nullptr;
+		map_size_ = 0;
+	}
+}
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace docgen {
+namespace io {
+
+/*
+ * Whole content of a file as one contiguous read-only span.
+ *
+ * Regular files of at least MAP_MIN_SIZE bytes are mapped (and read ahead sequentially),
+ * so that their content is never copied out of the page cache.
+ * Pages of a mapped file are only read in as they are first accessed (see touch).
+ * Anything else (small files, pipes, or files that cannot be mapped) is read
+ * into a buffer with as few reads as possible by the time the MappedFile is constructed.
+ * A mapped file that is truncated while mapped may crash the reader (SIGBUS),
+ * as with any mapping: only map files that are not written to meanwhile.
+ */
+class MappedFile
+{
+	public:
+		/* Smallest file mapped instead of read (mapping costs more than reading small files) */
+		static constexpr size_t MAP_MIN_SIZE = 16 << 10;
+
+		/*
+		 * Maps or reads file at path, or throws if it cannot be opened or read.
+		 */
+		explicit MappedFile(const char *path);
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		/*
+		 * Content of the file, valid as long as this MappedFile.
+		 */
+		std::string_view view() const { return view_; }
+
+		/*
+		 * Returns true if the file is mapped rather than read.
+		 */
+		bool mapped() const { return map_ != nullptr; }
+
+		/*
+		 * Reads a byte of every page of view() in [offset, offset + size),
+		 * so that those pages are in memory by the time it returns.
+		 * Lets waiting on input be timed apart from whatever reads the pages next.
+		 * Does nothing if the file was read rather than mapped.
+		 */
+		void touch(size_t offset, size_t size) const;
+
+	private:
+		void *map_ = nullptr;
+		size_t map_size_ = 0;
+		std::string buf_;
+		std::string_view view_;
+
+		void unmap_();
+};
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <string>
+#include "exceptions/exceptions.hpp"
+#include "io/path_filter.hpp"
+
+namespace docgen {
+namespace io {
+
+/* Most names a pattern may have (one bit of a state each, plus one for a full match) */
+static constexpr size_t MAX_NAMES = 63;
+
+/*
+ * Returns index of the ']' closing class starting at glob[i] == '[',
+ * or npos if there is none (a ']' right after the '[' or its negation is part of the class).
+ */
+static inline size_t class_end(std::string_view glob, size_t i)
+{
+	size_t j = i + 1;
+	if (j < glob.size() && (glob[j] == '!' || glob[j] == '^')) {
+		++j;
+	}
+	if (j < glob.size() && glob[j] == ']') {
+		++j;
+	}
+	return glob.find(']', j);
+}
+
+/*
+ * Returns true if c is in class [first, last) (within the brackets, without negation).
+ */
+static inline bool in_class(std::string_view glob, size_t first, size_t last, unsigned char c)
+{
+	for (size_t j = first; j < last; ) {
+		const unsigned char lo = glob[j];
+		if (j + 2 < last && glob[j + 1] == '-') {
+			if (lo <= c && c <= static_cast<unsigned char>(glob[j + 2])) {
+				return true;
+			}
+			j += 3;
+		}
+		else {
+			if (lo == c) {
+				return true;
+			}
+			++j;
+		}
+	}
+	return false;
+}
+
+/*
+ * Matches c against the item (char, escaped char, '?' or class) at glob[i], but '*'.
+ * Returns length of the item.
+ */
+static inline size_t match_item(std::string_view glob, size_t i, char c, bool& matched)
+{
+	switch (glob[i]) {
+		case '\\':
+			matched = glob[i + 1] == c;
+			return 2;
+		case '?':
+			matched = true;
+			return 1;
+		case '[':
+		{
+			const size_t end = class_end(glob, i);
+			const bool negated = glob[i + 1] == '!' || glob[i + 1] == '^';
+			const size_t first = i + 1 + negated;
+			matched = in_class(glob, first, end, c) != negated;
+			return end + 1 - i;
+		}
+		default:
+			matched = glob[i] == c;
+			return 1;
+	}
+}
+
+bool glob_match(std::string_view glob, std::string_view s)
+{
+	// on a mismatch, let the last '*' match one more char and go on from there
+	size_t g = 0;
+	size_t k = 0;
+	size_t star_g = std::string_view::npos;
+	size_t star_k = 0;
+	while (k < s.size()) {
+		if (g < glob.size() && glob[g] == '*') {
+			star_g = ++g;
+			star_k = k;
+			continue;
+		}
+		bool matched = false;
+		if (g < glob.size()) {
+			const size_t len = match_item(glob, g, s[k], matched);
+			if (matched) {
+				g += len;
+				++k;
+				continue;
+			}
+		}
+		if (star_g == std::string_view::npos) {
+			return false;
+		}
+		g = star_g;
+		k = ++star_k;
+	}
+	while (g < glob.size() && glob[g] == '*') {
+		++g;
+	}
+	return g == glob.size();
+}
+
+/*
+ * Throws if glob of a name of pattern is malformed.
+ */
+static inline void check_glob(const std::string& pattern, std::string_view glob)
+{
+	for (size_t i = 0; i < glob.size(); ++i) {
+		if (glob[i] == '\\') {
+			if (i + 1 == glob.size()) {
+				throw exceptions::bad_glob(pattern, "trailing \\");
+			}
+			++i;
+		}
+		else if (glob[i] == '[') {
+			i = class_end(glob, i);
+			if (i == std::string_view::npos) {
+				throw exceptions::bad_glob(pattern, "unterminated [");
+			}
+		}
+	}
+}
+
+PathFilter::PathFilter(const std::vector<std::string>& patterns)
+{
+	for (const std::string& text : patterns) {
+		pattern_t pattern;
+		std::string_view glob = text;
+		if (!glob.empty() && glob.front() == '!') {
+			pattern.exclude = true;
+			glob.remove_prefix(1);
+		}
+		while (!glob.empty() && glob.back() == '/') {
+			glob.remove_suffix(1);
+		}
+		if (glob.find('/') == std::string_view::npos) {
+			pattern.names.push_back({"**", true, false});
+		}
+
+		// split into names ("**" never twice in a row, empty names dropped)
+		bool named = false;
+		while (!glob.empty()) {
+			const size_t slash = std::min(glob.find('/'), glob.size());
+			const std::string_view name = glob.substr(0, slash);
+			glob.remove_prefix(std::min(slash + 1, glob.size()));
+			if (name.empty()) {
+				continue;
+			}
+			named = true;
+			if (name == "**") {
+				if (pattern.names.empty() || !pattern.names.back().any_depth) {
+					pattern.names.push_back({"**", true, false});
+				}
+				continue;
+			}
+			check_glob(text, name);
+			const bool literal = name.find_first_of("*?[\\") == std::string_view::npos;
+			pattern.names.push_back({std::string(name), false, literal});
+		}
+
+		if (!named) {
+			throw exceptions::bad_glob(text, "no name to match");
+		}
+		if (pattern.names.size() > MAX_NAMES) {
+			throw exceptions::bad_glob(text, "more than " + std::to_string(MAX_NAMES) + " names");
+		}
+		any_include_ |= !pattern.exclude;
+		patterns_.push_back(std::move(pattern));
+	}
+}
+
+uint64_t PathFilter::closure_(const pattern_t& pattern, uint64_t mask)
+{
+	// "**" may match no name at all
+	for (size_t j = 0; j < pattern.names.size(); ++j) {
+		if ((mask >> j & 1) && pattern.names[j].any_depth) {
+			mask |= uint64_t(1) << (j + 1);
+		}
+	}
+	return mask;
+}
+
+bool PathFilter::match_name_(const name_t& name, std::string_view s)
+{
+	return name.literal ? name.glob == s : glob_match(name.glob, s);
+}
+
+PathFilter::state_t PathFilter::root() const
+{
+	state_t state(patterns_.size());
+	for (size_t k = 0; k < patterns_.size(); ++k) {
+		state[k] = closure_(patterns_[k], 1);
+	}
+	return state;
+}
+
+PathFilter::state_t PathFilter::step(const state_t& state, std::string_view name) const
+{
+	state_t next(patterns_.size());
+	for (size_t k = 0; k < patterns_.size(); ++k) {
+		const pattern_t& pattern = patterns_[k];
+		const size_t n = pattern.names.size();
+		const uint64_t full = uint64_t(1) << n;
+
+		// whatever is in a matched directory is matched
+		if (state[k] & full) {
+			next[k] = full;
+			continue;
+		}
+		uint64_t mask = 0;
+		for (size_t j = 0; j < n; ++j) {
+			if (!(state[k] >> j & 1)) {
+				continue;
+			}
+			if (pattern.names[j].any_depth) {
+				mask |= uint64_t(1) << j;
+			}
+			else if (match_name_(pattern.names[j], name)) {
+				mask |= uint64_t(1) << (j + 1);
+			}
+		}
+		next[k] = closure_(pattern, mask);
+	}
+	return next;
+}
+
+bool PathFilter::includes(const state_t& state) const
+{
+	bool included = !any_include_;
+	for (size_t k = 0; k < patterns_.size(); ++k) {
+		if (state[k] >> patterns_[k].names.size() & 1) {
+			if (patterns_[k].exclude) {
+				return false;
+			}
+			included = true;
+		}
+	}
+	return included;
+}
+
+bool PathFilter::prunes(const state_t& state) const
+{
+	// an including pattern may still match something within as long as it matches a prefix
+	bool viable = !any_include_;
+	for (size_t k = 0; k < patterns_.size(); ++k) {
+		if (patterns_[k].exclude) {
+			if (state[k] >> patterns_[k].names.size() & 1) {
+				return true;
+			}
+		}
+		else if (state[k]) {
+			viable = true;
+		}
+	}
+	return !viable;
+}
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace docgen {
+namespace io {
+
+/*
+ * Set of glob patterns telling which files to parse within a walked directory,
+ * matched against paths relative to it, one name at a time as the walk goes down
+ * (so that whole subdirectories are left out without being listed).
+ *
+ * A pattern is a '/'-separated path of names where '*' matches any chars
+ * but '/', '?' matches any one of them, "[...]" matches one of a class of them
+ * (negated with a leading '!' or '^', with ranges as in "a-z"), '\' escapes a char
+ * and a name "**" matches any number of names (including none).
+ * A pattern without any '/' (but a trailing one) matches at any depth,
+ * any other only from the walked directory (a leading '/' being dropped).
+ * A pattern that matches a directory matches everything in it.
+ *
+ * A pattern starting with '!' excludes whatever it matches; any other includes it.
+ * A file is included if it matches no excluding pattern and, if there are including
+ * patterns, at least one of them, e.g. {"*.hpp", "*.cpp", "!third_party"}.
+ */
+class PathFilter
+{
+	public:
+		/*
+		 * Match state of a path: which names of every pattern it matches so far.
+		 */
+		using state_t = std::vector<uint64_t>;
+
+		/*
+		 * Compiles patterns, or throws exceptions::bad_glob if any of them is malformed.
+		 */
+		explicit PathFilter(const std::vector<std::string>& patterns);
+
+		/*
+		 * Returns true if there is no pattern at all, i.e. everything is included.
+		 */
+		bool empty() const { return patterns_.empty(); }
+
+		/*
+		 * State of the walked directory itself.
+		 */
+		state_t root() const;
+
+		/*
+		 * State of entry name of directory of state.
+		 */
+		state_t step(const state_t& state, std::string_view name) const;
+
+		/*
+		 * Returns true if file of state is included.
+		 */
+		bool includes(const state_t& state) const;
+
+		/*
+		 * Returns true if nothing in directory of state can be included.
+		 */
+		bool prunes(const state_t& state) const;
+
+	private:
+		struct name_t
+		{
+			std::string glob;
+			bool any_depth = false; // "**"
+			bool literal = false;   // no special char (glob is the name itself)
+		};
+
+		struct pattern_t
+		{
+			std::vector<name_t> names;
+			bool exclude = false;
+		};
+
+		std::vector<pattern_t> patterns_;
+		bool any_include_ = false;
+
+		static uint64_t closure_(const pattern_t& pattern, uint64_t mask);
+		static bool match_name_(const name_t& name, std::string_view s);
+};
+
+/*
+ * Returns true if s matches glob of a single name (as in PathFilter, without "**").
+ * glob must be well formed.
+ */
+bool glob_match(std::string_view glob, std::string_view s);
+
+} // namespace io
+} // namespace docgen
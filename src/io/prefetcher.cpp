@@ -0,0 +1,77 @@
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <climits>
+#include <utility>
+#include "io/prefetcher.hpp"
+
+namespace docgen {
+namespace io {
+
+Prefetcher::Prefetcher(std::vector<const char *> paths, size_t depth)
+	: paths_(std::move(paths)), depth_(depth)
+{
+	if (depth_ && !paths_.empty()) {
+		thread_ = std::thread(&Prefetcher::run_, this);
+	}
+}
+
+Prefetcher::~Prefetcher()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopped_ = true;
+	}
+	cv_.notify_one();
+	if (thread_.joinable()) {
+		thread_.join();
+	}
+}
+
+void Prefetcher::start()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++started_;
+	}
+	cv_.notify_one();
+}
+
+void Prefetcher::run_()
+{
+	for (size_t k = 0; k < paths_.size(); ++k) {
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_.wait(lock, [this, k]() { return stopped_ || k < started_ + depth_; });
+			if (stopped_) {
+				return;
+			}
+		}
+
+		// a file that cannot be opened is left for its reader to report
+		int fd = open(paths_[k], O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			++done_;
+			continue;
+		}
+#if defined(POSIX_FADV_WILLNEED)
+		posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)
+		// macOS has no posix_fadvise, but reads ahead a given range
+		struct stat st;
+		if (fstat(fd, &st) == 0) {
+			struct radvisory advice;
+			advice.ra_offset = 0;
+			advice.ra_count = static_cast<int>(std::min<off_t>(st.st_size, INT_MAX));
+			fcntl(fd, F_RDADVISE, &advice);
+		}
+#endif
+		close(fd);
+		++opened_;
+		++done_;
+	}
+}
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace docgen {
+namespace io {
+
+/*
+ * Reads files ahead of whoever parses them, so that their content is
+ * in the page cache (instead of on disk or across the network) by the time it is read.
+ *
+ * A thread of its own walks paths in the order given, asking the OS to read every file
+ * in the background (posix_fadvise WILLNEED, or F_RDADVISE on macOS;
+ * nothing where neither exists), but stays at most depth files ahead
+ * of the files started so far (see start), so as not to evict what it read
+ * before it is used.
+ */
+class Prefetcher
+{
+	public:
+		/*
+		 * Reads ahead files at paths in order (paths must outlive the Prefetcher).
+		 * Does nothing if depth is 0.
+		 */
+		Prefetcher(std::vector<const char *> paths, size_t depth);
+
+		/*
+		 * Stops reading ahead (files already asked for may still be read).
+		 */
+		~Prefetcher();
+
+		/*
+		 * Tells that one more file (in any order) is being parsed, letting the Prefetcher
+		 * go on to the next file past depth. Thread-safe.
+		 */
+		void start();
+
+		/*
+		 * Number of files gone through so far: asked to be read ahead,
+		 * or skipped if they cannot be opened.
+		 */
+		size_t done() const { return done_; }
+
+		/*
+		 * Number of those that could be opened (and were asked to be read ahead).
+		 */
+		size_t opened() const { return opened_; }
+
+	private:
+		std::vector<const char *> paths_;
+		size_t depth_;
+		std::mutex mutex_;
+		std::condition_variable cv_;
+		size_t started_ = 0;
+		bool stopped_ = false;
+		std::atomic<size_t> done_{0};
+		std::atomic<size_t> opened_{0};
+		std::thread thread_;
+
+		void run_();
+};
+
+} // namespace io
+} // namespace docgen
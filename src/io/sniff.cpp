@@ -0,0 +1,73 @@
+#include <cstdint>
+#include <cstring>
+#include "io/sniff.hpp"
+
+namespace docgen {
+namespace io {
+
+/*
+ * Returns number of continuation bytes following lead byte c of a UTF-8 sequence,
+ * or -1 if c cannot lead one.
+ */
+static inline int continuation_count(unsigned char c)
+{
+	if (c >= 0xc2 && c <= 0xdf) {
+		return 1;
+	}
+	if (c >= 0xe0 && c <= 0xef) {
+		return 2;
+	}
+	if (c >= 0xf0 && c <= 0xf4) {
+		return 3;
+	}
+	return -1;
+}
+
+bool looks_binary(std::string_view content)
+{
+	const std::string_view head = content.substr(0, SNIFF_SIZE);
+	if (memchr(head.data(), 0, head.size())) {
+		return true;
+	}
+
+	// only lead and continuation bytes are checked (not overlong encodings and the like)
+	size_t invalid = 0;
+	for (size_t i = 0; i < head.size(); ) {
+		// ASCII 8 bytes at a time
+		if (i + 8 <= head.size()) {
+			uint64_t word;
+			memcpy(&word, head.data() + i, 8);
+			if (!(word & 0x8080808080808080)) {
+				i += 8;
+				continue;
+			}
+		}
+		const unsigned char c = head[i];
+		if (c < 0x80) {
+			++i;
+			continue;
+		}
+		const int n = continuation_count(c);
+		if (n < 0) {
+			++invalid;
+			++i;
+			continue;
+		}
+		int k = 1;
+		while (k <= n && i + k < head.size() &&
+		       (static_cast<unsigned char>(head[i + k]) & 0xc0) == 0x80) {
+			++k;
+		}
+		// a sequence cut off by the end of head is taken as valid
+		if (k <= n && i + k < head.size()) {
+			++invalid;
+			++i;
+			continue;
+		}
+		i += k;
+	}
+	return invalid * 10 > head.size();
+}
+
+} // namespace io
+} // namespace docgen
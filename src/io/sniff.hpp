@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace docgen {
+namespace io {
+
+/* Number of bytes at the beginning of a file looks_binary looks at */
+static constexpr size_t SNIFF_SIZE = 8 << 10;
+
+/*
+ * Returns true if content (of a file) looks binary rather than text,
+ * as told by its first SNIFF_SIZE bytes: binary if they hold a NUL byte
+ * or if more than 1 byte in 10 is not part of a valid UTF-8 sequence
+ * (which leaves text in most single-byte encodings as text).
+ */
+bool looks_binary(std::string_view content);
+
+} // namespace io
+} // namespace docgen
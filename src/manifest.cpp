@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include "exceptions/exceptions.hpp"
+#include "io/file_hash.hpp"
+#include "parallel.hpp"
+#include "parse_file.hpp"
+#include "manifest.hpp"
+
+namespace docgen {
+
+/* Manifest JSON keys */
+static constexpr const char * const FORMAT_KEY = "format";
+static constexpr const char * const VERSION_KEY = "version";
+static constexpr const char * const KEY_KEY = "key";
+static constexpr const char * const FILES_KEY = "files";
+static constexpr const char * const SIZE_KEY = "size";
+static constexpr const char * const MTIME_KEY = "mtime";
+static constexpr const char * const INODE_KEY = "inode";
+static constexpr const char * const HASH_KEY = "hash";
+static constexpr const char * const PARSED_KEY = "parsed";
+
+/* Layout of the manifest itself, to be bumped whenever it changes */
+static constexpr unsigned int FORMAT = 1;
+
+Manifest::Manifest(std::string path, nlohmann::json key)
+	: path_(std::move(path)), key_(std::move(key))
+{
+	std::ifstream in(path_);
+	if (in.fail()) {
+		return;
+	}
+	nlohmann::json manifest = nlohmann::json::parse(in, nullptr, false);
+	if (!manifest.is_object() ||
+	    manifest[FORMAT_KEY] != FORMAT ||
+	    manifest[VERSION_KEY] != DOCGEN_VERSION ||
+	    manifest[KEY_KEY] != key_ ||
+	    !manifest[FILES_KEY].is_object()) {
+		return;
+	}
+	files_ = std::move(manifest[FILES_KEY]);
+}
+
+/*
+ * Returns true if entry has every field a file is recorded with.
+ */
+static inline bool valid_entry(const nlohmann::json& entry)
+{
+	return entry.is_object() &&
+	       entry.contains(SIZE_KEY) && entry.contains(MTIME_KEY) && entry.contains(INODE_KEY) &&
+	       entry.contains(HASH_KEY) && entry[HASH_KEY].is_number_unsigned() &&
+	       entry.contains(PARSED_KEY);
+}
+
+/*
+ * Returns true if recorded file entry has stat.
+ */
+static inline bool same_stat(const nlohmann::json& entry, const io::FileStat& stat)
+{
+	return entry[SIZE_KEY] == stat.size && entry[MTIME_KEY] == stat.mtime && entry[INODE_KEY] == stat.inode;
+}
+
+size_t Manifest::parse(const std::vector<std::string>& paths, const std::vector<io::FileStat>& stats,
+                       nlohmann::json& parsed, const core::lex::modal_lextable_t& lextable,
+                       const ParseOptions& options, ResultCache *cache)
+{
+	std::vector<nlohmann::json> results(paths.size());
+	std::vector<std::optional<uint64_t>> hashes(paths.size());
+
+	// reuse what was recorded for files with the same stat,
+	// and hash the others: those with the same content are reused as well
+	std::vector<const nlohmann::json *> entries(paths.size(), nullptr);
+	std::vector<size_t> changed;
+	for (size_t i = 0; i < paths.size(); ++i) {
+		auto it = files_.find(paths[i]);
+		if (it != files_.end() && valid_entry(*it)) {
+			entries[i] = &*it;
+		}
+		if (entries[i] && same_stat(*entries[i], stats[i])) {
+			hashes[i] = (*entries[i])[HASH_KEY].get<uint64_t>();
+			results[i] = (*entries[i])[PARSED_KEY];
+		}
+		else {
+			changed.push_back(i);
+		}
+	}
+
+	parallel::for_each_stealing(changed, std::min(options.jobs, changed.size()), [&](size_t i, size_t) {
+		try {
+			hashes[i] = io::hash_file(paths[i].c_str());
+		}
+		catch (const exceptions::exception&) {
+			// left to parsing to report
+		}
+	});
+
+	std::vector<std::string> parse_paths;
+	std::vector<uintmax_t> parse_sizes;
+	std::vector<size_t> parse_indices;
+	for (size_t i : changed) {
+		if (entries[i] && hashes[i] && (*entries[i])[HASH_KEY] == *hashes[i]) {
+			results[i] = (*entries[i])[PARSED_KEY];
+			continue;
+		}
+		parse_paths.push_back(paths[i]);
+		parse_sizes.push_back(stats[i].size);
+		parse_indices.push_back(i);
+	}
+
+	// record the hash of what was parsed (a file may have changed since it was hashed)
+	std::vector<nlohmann::json> parse_results;
+	if (cache) {
+		std::vector<std::optional<uint64_t>> parse_hashes;
+		for (size_t i : parse_indices) {
+			parse_hashes.push_back(hashes[i]);
+		}
+		parse_results = cache->parse_each(parse_paths, parse_sizes, parse_hashes, lextable, options);
+		for (size_t k = 0; k < parse_indices.size(); ++k) {
+			hashes[parse_indices[k]] = parse_hashes[k];
+		}
+	}
+	else {
+		std::vector<uint64_t> parse_hashes;
+		parse_results = parse_each(parse_paths, parse_sizes, lextable, options, &parse_hashes);
+		for (size_t k = 0; k < parse_indices.size(); ++k) {
+			hashes[parse_indices[k]] = parse_hashes[k];
+		}
+	}
+	for (size_t k = 0; k < parse_indices.size(); ++k) {
+		results[parse_indices[k]] = std::move(parse_results[k]);
+	}
+
+	// record exactly the files in paths
+	nlohmann::json files = nlohmann::json::object();
+	for (size_t i = 0; i < paths.size(); ++i) {
+		if (!results[i].is_null()) {
+			parsed.push_back(results[i]);
+		}
+		if (hashes[i]) {
+			files[paths[i]] = {
+				{SIZE_KEY, stats[i].size},
+				{MTIME_KEY, stats[i].mtime},
+				{INODE_KEY, stats[i].inode},
+				{HASH_KEY, *hashes[i]},
+				{PARSED_KEY, std::move(results[i])}
+			};
+		}
+	}
+	files_ = std::move(files);
+
+	return parse_paths.size();
+}
+
+void Manifest::save() const
+{
+	nlohmann::json manifest = {
+		{FORMAT_KEY, FORMAT},
+		{VERSION_KEY, DOCGEN_VERSION},
+		{KEY_KEY, key_},
+		{FILES_KEY, files_}
+	};
+
+	// write to a temporary file first, so that an interrupted run leaves the last manifest intact
+	const std::string tmp_path = path_ + ".tmp";
+	{
+		std::ofstream out(tmp_path);
+		if (out.fail()) {
+			throw exceptions::file_open_error(tmp_path);
+		}
+		out << manifest;
+		if (out.fail()) {
+			throw exceptions::system_error("failed to write manifest to \"" + tmp_path + '\"');
+		}
+	}
+	if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+		throw exceptions::system_error("failed to replace manifest at \"" + path_ + '\"');
+	}
+}
+
+} // namespace docgen
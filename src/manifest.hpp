@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "core/lex/modal_lextable.hpp"
+#include "io/dir_walker.hpp"
+#include "parse_file.hpp"
+#include "result_cache.hpp"
+
+namespace docgen {
+
+/*
+ * Record of every file parsed by the last run (its stat, a hash of its content
+ * and what parsing it appended), kept in a file between runs so that
+ * only files that changed since are parsed again.
+ *
+ * Parsing depends on the docgen version and on the lexemes recognized:
+ * whatever else it depends on (e.g. tags) is passed in as key,
+ * and a manifest recorded by another version or with another key is ignored.
+ */
+class Manifest
+{
+	public:
+		/*
+		 * Reads manifest at path if there is one (anything that cannot be read
+		 * as a manifest is ignored as if there were none).
+		 */
+		Manifest(std::string path, nlohmann::json key);
+
+		/*
+		 * Appends to parsed what parse_files would for every file in paths
+		 * (of which stats[i] is the stat of paths[i]), parsing only files that are new,
+		 * whose stat changed and whose content changed; what was recorded is reused for the rest.
+		 * Afterwards the manifest records exactly the files in paths
+		 * (i.e. files no longer there are dropped).
+		 * If cache is set, files to parse are looked up in it first (see ResultCache::parse_each).
+		 * Returns the number of files not reused from the manifest.
+		 */
+		size_t parse(const std::vector<std::string>& paths, const std::vector<io::FileStat>& stats,
+		             nlohmann::json& parsed, const core::lex::modal_lextable_t& lextable,
+		             const ParseOptions& options, ResultCache *cache = nullptr);
+
+		/*
+		 * Writes manifest to its path (replacing whatever was there at once).
+		 */
+		void save() const;
+
+	private:
+		std::string path_;
+		nlohmann::json key_;
+		nlohmann::json files_ = nlohmann::json::object(); // record of every file by name
+};
+
+} // namespace docgen
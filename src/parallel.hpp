@@ -0,0 +1,160 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace docgen {
+namespace parallel {
+
+/*
+ * Queue of task indices owned by one thread: the owner takes from the front,
+ * threads that ran out of tasks of their own steal from the back.
+ */
+class TaskQueue
+{
+	public:
+		void push(size_t task) { tasks_.push_back(task); } // only safe before any thread takes or steals
+		std::optional<size_t> take();
+		std::optional<size_t> steal();
+
+	private:
+		std::mutex mutex_;
+		std::deque<size_t> tasks_;
+};
+
+inline std::optional<size_t> TaskQueue::take()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (tasks_.empty()) {
+		return {};
+	}
+	size_t task = tasks_.front();
+	tasks_.pop_front();
+	return task;
+}
+
+inline std::optional<size_t> TaskQueue::steal()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (tasks_.empty()) {
+		return {};
+	}
+	size_t task = tasks_.back();
+	tasks_.pop_back();
+	return task;
+}
+
+/*
+ * Calls task(i, thread) for every index i in order on jobs threads,
+ * thread being the index in [0, jobs) of the calling thread
+ * (the thread that calls for_each_stealing is thread 0).
+ * Indices are dealt out to the threads round-robin, so that every thread starts
+ * with its share of the first ones in order (e.g. the largest files);
+ * a thread done with its own indices steals the last ones left of other threads
+ * until none are left anywhere. No task is called twice,
+ * and task must not throw. Returns once every call has returned.
+ */
+template <class Task>
+void for_each_stealing(const std::vector<size_t>& order, size_t jobs, Task&& task)
+{
+	if (jobs <= 1) {
+		for (size_t i : order) {
+			task(i, 0);
+		}
+		return;
+	}
+
+	std::vector<TaskQueue> queues(jobs);
+	for (size_t k = 0; k < order.size(); ++k) {
+		queues[k % jobs].push(order[k]);
+	}
+
+	auto work = [&queues, &task, jobs](size_t thread) {
+		// own tasks first
+		while (std::optional<size_t> i = queues[thread].take()) {
+			task(*i, thread);
+		}
+		// then anyone else's, nearest neighbour first
+		// (a queue found empty stays empty: tasks are never added back)
+		for (size_t k = 1; k < jobs; ++k) {
+			TaskQueue& victim = queues[(thread + k) % jobs];
+			while (std::optional<size_t> i = victim.steal()) {
+				task(*i, thread);
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(jobs - 1);
+	for (size_t thread = 1; thread < jobs; ++thread) {
+		threads.emplace_back(work, thread);
+	}
+	work(0);
+	for (std::thread& t : threads) {
+		t.join();
+	}
+}
+
+/*
+ * Calls task(item, thread, spawn) for first and for every item spawned along the way
+ * on jobs threads (thread as in for_each_stealing), where spawn(item) may be called
+ * from within task any number of times to have task called on item as well
+ * (e.g. on every subdirectory found while listing a directory).
+ * Items spawned last are called first, which keeps the number of items
+ * in flight down to about the depth of whatever is being spawned.
+ * task must not throw. Returns once no item is left and every call has returned.
+ */
+template <class Item, class Task>
+void for_each_spawning(Item first, size_t jobs, Task&& task)
+{
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::vector<Item> items;
+	size_t busy = 0; // number of threads in a call to task
+	items.push_back(std::move(first));
+
+	auto spawn = [&](Item item) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			items.push_back(std::move(item));
+		}
+		cv.notify_one();
+	};
+
+	auto work = [&](size_t thread) {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			cv.wait(lock, [&]() { return !items.empty() || !busy; });
+			if (items.empty()) {
+				// nothing left and nothing can be spawned anymore
+				cv.notify_all();
+				return;
+			}
+			Item item = std::move(items.back());
+			items.pop_back();
+			++busy;
+			lock.unlock();
+			task(std::move(item), thread, spawn);
+			lock.lock();
+			--busy;
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(jobs > 1 ? jobs - 1 : 0);
+	for (size_t thread = 1; thread < jobs; ++thread) {
+		threads.emplace_back(work, thread);
+	}
+	work(0);
+	for (std::thread& t : threads) {
+		t.join();
+	}
+}
+
+} // namespace parallel
+} // namespace docgen
@@ -1,58 +1,125 @@
-#include <cstdio>
-#include <string>
-#include "exceptions/exceptions.hpp"
-#include "core/lex/lexer.hpp"
-#include "core/parse/parser.hpp"
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <optional>
+#include "io/prefetcher.hpp"
+#include "parallel.hpp"
+#include "session.hpp"
 #include "parse_file.hpp"
 
-#define BUF_SZ 4096
-
 namespace docgen {
 
-static constexpr const char * const FILENAME_KEY = "name";
+void parse_file(const char *path, nlohmann::json& parsed, const core::lex::modal_lextable_t& lextable)
+{
+	Session(lextable).parse_file(path, parsed);
+}
 
 void parse_file(const char *path, nlohmann::json& parsed)
 {
-	// open file
-	FILE *file = fopen(path, "r");
-	if (file == nullptr) {
-		throw exceptions::file_open_error(path);
+	static thread_local Session session;
+	session.parse_file(path, parsed);
+}
+
+void parse_files(const std::vector<std::string>& paths, nlohmann::json& parsed,
+                 const core::lex::modal_lextable_t& lextable, size_t jobs)
+{
+	// a file that cannot be sized is scheduled last, and fails in order when opened
+	std::vector<uintmax_t> sizes(paths.size());
+	for (size_t i = 0; i < paths.size(); ++i) {
+		std::error_code ec;
+		sizes[i] = std::filesystem::file_size(paths[i], ec);
+		if (ec) {
+			sizes[i] = 0;
+		}
 	}
+	parse_files(paths, sizes, parsed, lextable, jobs);
+}
 
-	// initialize lexer and parser
-	core::lex::Lexer lexer;
-	core::parse::Parser parser;
-
-	// read file in by chunks
-	char buf[BUF_SZ];
-	size_t r, i;
-	std::optional<core::lex::Lexer::token_t> token;
-	while ((r = fread(buf, 1, BUF_SZ, file))) {
-		for (i = 0; i < r; ++i) {
-			// process lexer on every read character
-			lexer.process(buf[i]);
-			// process parser on every resolved token
-			while ((token = lexer.next_token())) {
-				parser.process(*token);
-			}
+void parse_files(const std::vector<std::string>& paths, const std::vector<uintmax_t>& sizes,
+                 nlohmann::json& parsed, const core::lex::modal_lextable_t& lextable, const ParseOptions& options)
+{
+	std::vector<nlohmann::json> results = parse_each(paths, sizes, lextable, options);
+	for (nlohmann::json& result : results) {
+		if (!result.is_null()) {
+			parsed.push_back(std::move(result));
 		}
 	}
-	if (ferror(file)) {
-		throw exceptions::system_error("fread() failed on file at path \"" + std::string(path) + '\"');
+}
+
+std::vector<nlohmann::json> parse_each(const std::vector<std::string>& paths, const std::vector<uintmax_t>& sizes,
+                                       const core::lex::modal_lextable_t& lextable, const ParseOptions& options,
+                                       std::vector<uint64_t> *hashes)
+{
+	// schedule larger files first
+	std::vector<size_t> order(paths.size());
+	for (size_t i = 0; i < paths.size(); ++i) {
+		order[i] = i;
 	}
-	fclose(file);
+	std::stable_sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+		return sizes[a] > sizes[b];
+	});
 
-	// flush lexer of remaining tokens process them with parser
-	lexer.flush();
-	while ((token = lexer.next_token())) {
-		parser.process(*token);
+	// read files ahead in about the order they are started in
+	std::vector<const char *> prefetch_paths;
+	if (options.prefetch) {
+		prefetch_paths.reserve(order.size());
+		for (size_t i : order) {
+			prefetch_paths.push_back(paths[i].c_str());
+		}
 	}
+	io::Prefetcher prefetcher(std::move(prefetch_paths), options.prefetch);
 
-	// if anything useful was parsed, move it into the json
-	if (!parser.parsed().is_null()) {
-		parsed.push_back(std::move(parser.parsed()));
-		parsed.back()[FILENAME_KEY] = path;
+	// every file gets its own slot, so that results are gathered in order
+	const size_t jobs = std::clamp<size_t>(options.jobs, 1, std::max<size_t>(paths.size(), 1));
+	std::vector<nlohmann::json> results(paths.size());
+	std::vector<std::exception_ptr> errors(paths.size());
+	std::vector<char> binary(paths.size(), false);
+	std::vector<std::optional<Session>> sessions(jobs);
+	if (hashes) {
+		hashes->assign(paths.size(), 0);
+	}
+
+	parallel::for_each_stealing(order, jobs, [&](size_t i, size_t thread) {
+		if (options.prefetch) {
+			prefetcher.start();
+		}
+		try {
+			if (!sessions[thread]) {
+				sessions[thread].emplace(lextable);
+				sessions[thread]->prefilter(options.prefilter);
+			}
+			nlohmann::json result;
+			binary[i] = !sessions[thread]->parse_file(paths[i].c_str(), result, hashes ? &(*hashes)[i] : nullptr);
+			if (!result.empty()) {
+				results[i] = std::move(result.back());
+			}
+		}
+		catch (...) {
+			errors[i] = std::current_exception();
+		}
+	});
+
+	if (options.stats) {
+		options.stats->files += paths.size();
+		for (const std::optional<Session>& session : sessions) {
+			if (session) {
+				options.stats->input_wait += session->input_wait();
+				options.stats->skipped += session->skipped();
+			}
+		}
+		for (size_t i = 0; i < paths.size(); ++i) {
+			if (binary[i]) {
+				options.stats->binary.push_back(paths[i]);
+			}
+		}
+	}
+
+	for (std::exception_ptr& error : errors) {
+		if (error) {
+			std::rethrow_exception(error);
+		}
 	}
+	return results;
 }
 
 } // namespace docgen
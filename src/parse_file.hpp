@@ -1,9 +1,81 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
 #include <nlohmann/json.hpp>
+#include "core/lex/modal_lextable.hpp"
 
 namespace docgen {
 
+/*
+ * Statistics of parse_each, added to by every call given them (see ParseOptions).
+ * Only files parse_each reads are counted: those whose result is reused
+ * (see Manifest and ResultCache) are not read again, so whether they look binary
+ * or have no doc comment is not known.
+ */
+struct ParseStats
+{
+	size_t files = 0;                           // number of files read, including those skipped below
+	size_t skipped = 0;                         // number of those without any doc comment (see Session::prefilter)
+	std::vector<std::string> binary;            // paths of those that look binary, in order (see Session::sniff)
+	std::chrono::nanoseconds input_wait{0};     // time spent waiting for files to be read, over every thread
+};
+
+/*
+ * How parse_each goes about parsing files.
+ * Converts from a number of jobs, with everything else left as default.
+ */
+struct ParseOptions
+{
+	size_t jobs = 1;                // number of threads parsing files
+	size_t prefetch = 0;            // number of files read ahead of those being parsed (see io::Prefetcher)
+	bool prefilter = false;         // skip files without doc comments, dropping undocumented template classes (see Session::prefilter)
+	ParseStats *stats = nullptr;    // if set, added to
+
+	ParseOptions(size_t jobs = 1) : jobs(jobs) {}
+};
+
+/*
+ * Parses file at path and appends anything parsed to parsed.
+ * Builds a new lexer and parser (see Session to parse many files with the same ones).
+ * The lexer recognizes exactly the lexemes in lextable
+ * (within the mode each of them belongs to).
+ */
+void parse_file(const char *path, nlohmann::json& parsed, const core::lex::modal_lextable_t& lextable);
+
+/*
+ * Same as above with the default lexemes (see make_modal_lextable),
+ * with a lexer and parser kept for the calling thread.
+ */
 void parse_file(const char *path, nlohmann::json& parsed);
 
+/*
+ * Parses every file in paths on jobs threads (one Session each)
+ * and appends anything parsed to parsed in the order of paths,
+ * i.e. with the same result as calling parse_file on every path in turn.
+ * Larger files are started first, so that none is left to finish alone at the end.
+ * If parsing any file throws, what the first of them in paths threw
+ * is rethrown once every file is done, and parsed is left untouched.
+ */
+void parse_files(const std::vector<std::string>& paths, nlohmann::json& parsed,
+                 const core::lex::modal_lextable_t& lextable, size_t jobs);
+
+/*
+ * Same as above with sizes[i] the size of file at paths[i] (e.g. as io::walk_dir found it).
+ */
+void parse_files(const std::vector<std::string>& paths, const std::vector<uintmax_t>& sizes,
+                 nlohmann::json& parsed, const core::lex::modal_lextable_t& lextable, const ParseOptions& options);
+
+/*
+ * Same as above, except that what parsing every file appended (null if nothing)
+ * is returned instead, in the order of paths.
+ * If hashes is set, it is set to the io::hash_bytes of exactly what was parsed of every file
+ * (e.g. for results to be stored by content, see ResultCache).
+ */
+std::vector<nlohmann::json> parse_each(const std::vector<std::string>& paths, const std::vector<uintmax_t>& sizes,
+                                       const core::lex::modal_lextable_t& lextable, const ParseOptions& options,
+                                       std::vector<uint64_t> *hashes = nullptr);
+
 } // namespace docgen
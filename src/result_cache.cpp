@@ -0,0 +1,232 @@
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include "exceptions/exceptions.hpp"
+#include "io/file_hash.hpp"
+#include "parallel.hpp"
+#include "parse_file.hpp"
+#include "session.hpp"
+#include "result_cache.hpp"
+
+namespace docgen {
+
+/* Layout of entries, to be bumped whenever it changes */
+static constexpr const char * const FORMAT = "1";
+
+static constexpr const char * const ENTRY_SUFFIX = ".cbor";
+
+ResultCache::ResultCache(std::string dir, const nlohmann::json& key, uintmax_t max_size)
+	: dir_(std::move(dir)), max_size_(max_size)
+{
+	key_hash_ = io::hash_bytes(FORMAT);
+	key_hash_ = io::hash_bytes(DOCGEN_VERSION, key_hash_);
+	key_hash_ = io::hash_bytes(key.dump(), key_hash_);
+}
+
+std::string ResultCache::entry_path_(uint64_t hash) const
+{
+	// spread entries over subdirectories named by the first two hex digits of hash
+	char name[64];
+	snprintf(name, sizeof(name), "%016" PRIx64 "-%016" PRIx64, hash, key_hash_);
+	return dir_ + '/' + std::string(name, 2) + '/' + name + ENTRY_SUFFIX;
+}
+
+std::optional<nlohmann::json> ResultCache::load(uint64_t hash, const std::string& name) const
+{
+	const std::string path = entry_path_(hash);
+	std::ifstream in(path, std::ios::binary);
+	if (in.fail()) {
+		return {};
+	}
+	std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+	nlohmann::json result = nlohmann::json::from_cbor(bytes, true, false);
+	if (result.is_discarded()) {
+		return {};
+	}
+
+	// mark entry as used (see evict)
+	utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+
+	if (result.is_object()) {
+		result[FILENAME_KEY] = name;
+	}
+	return result;
+}
+
+void ResultCache::store(uint64_t hash, const nlohmann::json& result) const
+{
+	// result is the same wherever the file is, except for its name
+	std::vector<uint8_t> bytes;
+	if (result.is_object()) {
+		nlohmann::json unnamed = result;
+		unnamed.erase(FILENAME_KEY);
+		bytes = nlohmann::json::to_cbor(unnamed);
+	}
+	else {
+		bytes = nlohmann::json::to_cbor(result);
+	}
+
+	// write under a name no other writer uses, then move into place at once
+	namespace fs = std::filesystem;
+	const fs::path path = entry_path_(hash);
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+	const fs::path tmp_path = path.parent_path() / (TMP_PREFIX + path.filename().string() + '.' +
+		std::to_string(getpid()) + '.' + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())));
+	{
+		std::ofstream out(tmp_path, std::ios::binary);
+		out.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+		if (out.fail()) {
+			out.close();
+			fs::remove(tmp_path, ec);
+			return;
+		}
+	}
+	if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+		fs::remove(tmp_path, ec);
+	}
+}
+
+std::vector<nlohmann::json> ResultCache::parse_each(const std::vector<std::string>& paths, const std::vector<uintmax_t>& sizes,
+                                                    std::vector<std::optional<uint64_t>>& hashes,
+                                                    const core::lex::modal_lextable_t& lextable, const ParseOptions& options)
+{
+	std::vector<nlohmann::json> results(paths.size());
+	std::vector<char> hit(paths.size(), false);
+
+	// hash whatever is yet to be and look up every file
+	std::vector<size_t> all(paths.size());
+	for (size_t i = 0; i < paths.size(); ++i) {
+		all[i] = i;
+	}
+	parallel::for_each_stealing(all, std::min(options.jobs, paths.size()), [&](size_t i, size_t) {
+		if (!hashes[i]) {
+			try {
+				hashes[i] = io::hash_file(paths[i].c_str());
+			}
+			catch (const exceptions::exception&) {
+				// left to parsing to report
+				return;
+			}
+		}
+		if (std::optional<nlohmann::json> result = load(*hashes[i], paths[i])) {
+			results[i] = std::move(*result);
+			hit[i] = true;
+			++hits_;
+		}
+	});
+
+	// parse the others and store their result under the hash of what was parsed
+	// (a file may have changed since it was hashed)
+	std::vector<std::string> miss_paths;
+	std::vector<uintmax_t> miss_sizes;
+	std::vector<size_t> miss_indices;
+	for (size_t i = 0; i < paths.size(); ++i) {
+		if (!hit[i]) {
+			miss_paths.push_back(paths[i]);
+			miss_sizes.push_back(sizes[i]);
+			miss_indices.push_back(i);
+		}
+	}
+	std::vector<uint64_t> miss_hashes;
+	std::vector<nlohmann::json> miss_results = docgen::parse_each(miss_paths, miss_sizes, lextable, options, &miss_hashes);
+	for (size_t k = 0; k < miss_indices.size(); ++k) {
+		results[miss_indices[k]] = std::move(miss_results[k]);
+		hashes[miss_indices[k]] = miss_hashes[k];
+	}
+
+	std::vector<size_t> misses(miss_indices.size());
+	for (size_t k = 0; k < misses.size(); ++k) {
+		misses[k] = k;
+	}
+	parallel::for_each_stealing(misses, std::min(options.jobs, misses.size()), [&](size_t k, size_t) {
+		store(miss_hashes[k], results[miss_indices[k]]);
+	});
+
+	return results;
+}
+
+size_t ResultCache::evict() const
+{
+	namespace fs = std::filesystem;
+	struct entry_t
+	{
+		fs::file_time_type mtime;
+		uintmax_t size;
+		fs::path path;
+	};
+
+	// entries are all in subdirectories of dir_ (see entry_path_), listed one at a time
+	// so that one removed meanwhile (e.g. by another run) does not end the listing
+	std::vector<fs::path> subdirs;
+	std::error_code ec;
+	for (fs::directory_iterator it(dir_, ec), end; !ec && it != end; it.increment(ec)) {
+		std::error_code entry_ec;
+		if (it->is_directory(entry_ec)) {
+			subdirs.push_back(it->path());
+		}
+	}
+
+	std::vector<entry_t> entries;
+	uintmax_t total = 0;
+	const fs::file_time_type now = fs::file_time_type::clock::now();
+	for (const fs::path& subdir : subdirs) {
+		for (fs::directory_iterator it(subdir, ec), end; !ec && it != end; it.increment(ec)) {
+			// any entry may be gone by the time it is looked at
+			std::error_code entry_ec;
+			if (!it->is_regular_file(entry_ec)) {
+				continue;
+			}
+			const std::string name = it->path().filename().string();
+			fs::file_time_type mtime = it->last_write_time(entry_ec);
+			if (entry_ec) {
+				continue;
+			}
+			if (name.rfind(TMP_PREFIX, 0) == 0) {
+				if (now - mtime > TMP_MAX_AGE) {
+					fs::remove(it->path(), entry_ec);
+				}
+				continue;
+			}
+			uintmax_t size = it->file_size(entry_ec);
+			if (entry_ec) {
+				continue;
+			}
+			entries.push_back({mtime, size, it->path()});
+			total += size;
+		}
+	}
+
+	if (total <= max_size_) {
+		return 0;
+	}
+
+	// least recently used first
+	std::sort(entries.begin(), entries.end(), [](const entry_t& a, const entry_t& b) {
+		return a.mtime < b.mtime;
+	});
+	size_t removed = 0;
+	const uintmax_t target = max_size_ * EVICT_TO;
+	for (const entry_t& entry : entries) {
+		if (total <= target) {
+			break;
+		}
+		// may be gone already (e.g. evicted by another run)
+		if (fs::remove(entry.path, ec)) {
+			++removed;
+		}
+		total -= entry.size;
+	}
+	return removed;
+}
+
+} // namespace docgen
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "core/lex/modal_lextable.hpp"
+#include "parse_file.hpp"
+
+namespace docgen {
+
+/*
+ * Directory of parse results addressed by content: the result of parsing
+ * any file with the same bytes (with the same docgen version and key,
+ * e.g. tags) is the same wherever the file is, so a ResultCache may be shared
+ * by any number of checkouts and runs, including concurrent ones.
+ *
+ * Every result is kept in its own file (as CBOR, without its name), written
+ * under a temporary name and renamed into place, so that readers only ever
+ * see whole entries. Entries are touched whenever they are used,
+ * and evict() removes those used least recently.
+ */
+class ResultCache
+{
+	public:
+		/* Fraction of max_size evict() leaves the cache at */
+		static constexpr double EVICT_TO = 0.9;
+
+		/* Prefix of the name of an entry being written */
+		static constexpr const char * const TMP_PREFIX = ".tmp.";
+
+		/* Age after which a temporary file is taken to be left behind by an interrupted run */
+		static constexpr std::chrono::hours TMP_MAX_AGE{1};
+
+		/*
+		 * Cache in directory at dir (created on first store) for results
+		 * of parsing with lexemes described by key, holding about max_size bytes at most.
+		 */
+		ResultCache(std::string dir, const nlohmann::json& key, uintmax_t max_size);
+
+		/*
+		 * Returns what parse_each would for every file in paths, taking the result
+		 * of a file from the cache if its content is there and parsing it otherwise
+		 * (after which its result is stored).
+		 * hashes[i] is the io::hash_file of paths[i] if already known (otherwise it is hashed)
+		 * and is set to that of what was parsed of it if it was.
+		 */
+		std::vector<nlohmann::json> parse_each(const std::vector<std::string>& paths, const std::vector<uintmax_t>& sizes,
+		                                       std::vector<std::optional<uint64_t>>& hashes,
+		                                       const core::lex::modal_lextable_t& lextable, const ParseOptions& options);
+
+		/*
+		 * Returns result stored for content of hash (named name), if any.
+		 */
+		std::optional<nlohmann::json> load(uint64_t hash, const std::string& name) const;
+
+		/*
+		 * Stores result for content of hash. Failing to store is not an error
+		 * (e.g. another run evicting at the same time): the result is just not cached.
+		 */
+		void store(uint64_t hash, const nlohmann::json& result) const;
+
+		/*
+		 * If the cache holds more than max_size bytes, removes the entries used least recently
+		 * until it holds no more than EVICT_TO of it (so that not every run has to evict),
+		 * along with temporary files left behind by runs that were interrupted.
+		 * Entries (or subdirectories) removed meanwhile by another run are skipped.
+		 * Returns the number of entries removed.
+		 */
+		size_t evict() const;
+
+		/*
+		 * Number of results taken from the cache by parse_each so far.
+		 */
+		size_t hits() const { return hits_; }
+
+	private:
+		std::string dir_;
+		uint64_t key_hash_;
+		uintmax_t max_size_;
+		std::atomic<size_t> hits_ = 0;
+
+		std::string entry_path_(uint64_t hash) const;
+};
+
+} // namespace docgen
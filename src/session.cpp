@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstring>
+#include "io/file_hash.hpp"
+#include "io/mapped_file.hpp"
+#include "io/sniff.hpp"
+#include "session.hpp"
+
+namespace docgen {
+
+/* Size of the windows a file is lexed by, and a mapped file faulted in by (see Session::parse_file) */
+static constexpr size_t INPUT_WINDOW = 1 << 20;
+
+Session::Session(const core::lex::modal_lextable_t& lextable)
+	: lexer_(lextable)
+{
+	lexer_.coalesce(true);
+}
+
+Session::Session()
+	: Session(core::lex::make_modal_lextable())
+{}
+
+void Session::start_()
+{
+	lexer_.restore(core::lex::ModalLexer::snapshot_t());
+	lexer_.want_text(true);
+	parser_.reset();
+}
+
+void Session::to_parser_(core::lex::ModalLexer::token_t&& token)
+{
+	parser_.process(token);
+	if (parser_.skip_block_requested()) {
+		lexer_.skip_block();
+	}
+	lexer_.want_text(parser_.needs_text());
+}
+
+void Session::finish_(nlohmann::json& parsed, const char *name)
+{
+	// flush lexer of remaining tokens process them with parser
+	lexer_.flush([this](core::lex::ModalLexer::token_t&& token) { to_parser_(std::move(token)); });
+
+	// if anything useful was parsed, move it into the json
+	if (!parser_.parsed().is_null()) {
+		parsed.push_back(std::move(parser_.parsed()));
+		parsed.back()[FILENAME_KEY] = name;
+	}
+}
+
+/*
+ * Returns true if buffer holds the opener of a doc line or doc block comment
+ * (see make_lexeme_symbol_pairs). Only the '/' are looked at, which memchr finds many bytes at a time.
+ */
+static inline bool has_doc_comment(std::string_view buffer)
+{
+	const char *it = buffer.data();
+	const char * const end = it + buffer.size();
+	while (end - it >= 3 && (it = static_cast<const char *>(memchr(it, '/', end - it - 2)))) {
+		if ((it[1] == '/' && it[2] == '/') || (it[1] == '*' && it[2] == '!')) {
+			return true;
+		}
+		++it;
+	}
+	return false;
+}
+
+template <class Reach>
+void Session::parse_(std::string_view buffer, nlohmann::json& parsed, const char *name, Reach&& reach)
+{
+	if (prefilter_) {
+		// windows overlap by 2 chars, for an opener across windows to be found
+		bool found = false;
+		for (size_t first = 0; !found && first < buffer.size(); first += INPUT_WINDOW) {
+			const size_t last = std::min(first + INPUT_WINDOW, buffer.size());
+			reach(last);
+			const size_t from = first < 2 ? 0 : first - 2;
+			found = has_doc_comment(buffer.substr(from, last - from));
+		}
+		if (!found) {
+			++skipped_;
+			return;
+		}
+	}
+
+	// lexer state carries across windows, as if the buffer was lexed at once
+	start_();
+	auto sink = [this](core::lex::ModalLexer::token_t&& token) { to_parser_(std::move(token)); };
+	for (size_t first = 0; first < buffer.size(); first += INPUT_WINDOW) {
+		const std::string_view window = buffer.substr(first, INPUT_WINDOW);
+		reach(first + window.size());
+		lexer_.process(window, sink);
+	}
+	finish_(parsed, name);
+}
+
+void Session::parse_buffer(std::string_view buffer, nlohmann::json& parsed, const char *name)
+{
+	parse_(buffer, parsed, name, [](size_t) {});
+}
+
+bool Session::parse_file(const char *path, nlohmann::json& parsed, uint64_t *hash)
+{
+	// reading a file that is not mapped is all the waiting on it there is
+	auto begin = std::chrono::steady_clock::now();
+	io::MappedFile file(path);
+	input_wait_ += std::chrono::steady_clock::now() - begin;
+	const std::string_view view = file.view();
+
+	// pages of a mapped file are faulted in (and waited for) just before
+	// they are first read, while the kernel reads ahead of them
+	size_t reached = 0;
+	auto reach = [&](size_t last) {
+		if (last <= reached || !file.mapped()) {
+			return;
+		}
+		auto touch_begin = std::chrono::steady_clock::now();
+		file.touch(reached, last - reached);
+		input_wait_ += std::chrono::steady_clock::now() - touch_begin;
+		reached = last;
+	};
+
+	if (hash) {
+		*hash = io::HASH_SEED;
+		for (size_t first = 0; first < view.size(); first += INPUT_WINDOW) {
+			const std::string_view window = view.substr(first, INPUT_WINDOW);
+			reach(first + window.size());
+			*hash = io::hash_bytes(window, *hash);
+		}
+	}
+	if (sniff_) {
+		reach(std::min(io::SNIFF_SIZE, view.size()));
+		if (io::looks_binary(view)) {
+			return false;
+		}
+	}
+	parse_(view, parsed, path, reach);
+	return true;
+}
+
+void parse_buffer(std::string_view buffer, nlohmann::json& parsed, const char *name)
+{
+	static thread_local Session session;
+	session.parse_buffer(buffer, parsed, name);
+}
+
+} // namespace docgen
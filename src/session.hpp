@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <nlohmann/json.hpp>
+#include "core/lex/lexer.hpp"
+#include "core/parse/parser.hpp"
+
+namespace docgen {
+
+/* Key at which anything parsed from an input holds its name (e.g. file path) */
+static constexpr const char * const FILENAME_KEY = "name";
+
+/*
+ * Parses any number of inputs in turn with one lexer and one parser,
+ * which are only built once (building the lexer copies its whole lextable).
+ * Embedders that parse many buffers in-process should keep a Session around
+ * instead of paying for a new lexer and parser on every input.
+ * Not thread-safe: use one Session per thread.
+ */
+class Session
+{
+	public:
+		/*
+		 * The lexer recognizes exactly the lexemes in lextable
+		 * (within the mode each of them belongs to).
+		 */
+		explicit Session(const core::lex::modal_lextable_t& lextable);
+
+		/*
+		 * Same as above with the default lexemes (see make_modal_lextable).
+		 */
+		Session();
+
+		/*
+		 * Parses buffer and appends anything parsed to parsed, named name.
+		 * buffer is only read during this call.
+		 */
+		void parse_buffer(std::string_view buffer, nlohmann::json& parsed, const char *name);
+
+		/*
+		 * Parses file at path and appends anything parsed to parsed, named path.
+		 * The whole file is parsed as one buffer (see io::MappedFile), of which
+		 * pages are faulted in a window at a time just before they are first read.
+		 * If hash is set, it is set to the io::hash_bytes of exactly what was parsed.
+		 * Returns false if the file was not parsed as it looks binary (see sniff).
+		 */
+		bool parse_file(const char *path, nlohmann::json& parsed, uint64_t *hash = nullptr);
+
+		/*
+		 * Total time parse_file spent waiting for files to be read
+		 * (reading files that are not mapped and faulting in those that are).
+		 */
+		std::chrono::nanoseconds input_wait() const { return input_wait_; }
+
+		/*
+		 * Sets whether inputs without any doc comment opener (of a doc line or a doc block) are skipped
+		 * without being lexed. Off by default, as undocumented template classes are still parsed
+		 * (see ClassWorker): only turn it on if nothing but documented entities is wanted
+		 * and the lextable has no other doc comment openers.
+		 */
+		void prefilter(bool enabled) { prefilter_ = enabled; }
+
+		/*
+		 * Number of inputs skipped so far (see prefilter).
+		 */
+		size_t skipped() const { return skipped_; }
+
+		/*
+		 * Sets whether parse_file skips files that look binary (see io::looks_binary)
+		 * without lexing them. On by default.
+		 */
+		void sniff(bool enabled) { sniff_ = enabled; }
+
+	private:
+		core::lex::ModalLexer lexer_;
+		core::parse::Parser parser_;
+		std::chrono::nanoseconds input_wait_{0};
+		bool prefilter_ = false;
+		bool sniff_ = true;
+		size_t skipped_ = 0;
+
+		/*
+		 * Clears whatever the last input left in the lexer and parser,
+		 * including after an input that could not be read to the end.
+		 */
+		void start_();
+
+		/*
+		 * Processes parser on a token and skips whatever the parser has no use for.
+		 */
+		void to_parser_(core::lex::ModalLexer::token_t&& token);
+
+		/*
+		 * Flushes lexer and moves anything parsed into parsed.
+		 */
+		void finish_(nlohmann::json& parsed, const char *name);
+
+		/*
+		 * Parses buffer (see parse_buffer) a window at a time,
+		 * calling reach(n) before the first n chars of buffer are read.
+		 */
+		template <class Reach>
+		void parse_(std::string_view buffer, nlohmann::json& parsed, const char *name, Reach&& reach);
+};
+
+/*
+ * Parses buffer with a Session of the default lexemes kept for the calling thread,
+ * and appends anything parsed to parsed, named name.
+ */
+void parse_buffer(std::string_view buffer, nlohmann::json& parsed, const char *name);
+
+} // namespace docgen
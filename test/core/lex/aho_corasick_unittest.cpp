@@ -0,0 +1,166 @@
+#include <core/lex/aho_corasick.hpp>
+#include <core/lex/lexer.hpp>
+#include <core/utils/trie_base_fixture.hpp>
+#include <string>
+#include <vector>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct aho_corasick_fixture : utils::trie_base_fixture
+{
+protected:
+    using table_t = AhoCorasickTable<symbol_t>;
+    using lexer_t = AhoCorasickLexer<Symbol>;
+    using token_t = lexer_t::token_t;
+
+    static lexer_t make_lexer()
+    {
+        return lexer_t(aho_corasick_table_t(lexeme_symbol_arr.begin(), lexeme_symbol_arr.end()));
+    }
+
+    static std::vector<token_t> lex(lexer_t& lexer, const char* content)
+    {
+        for (const char* c = content; *c; ++c) {
+            lexer.process(*c);
+        }
+        lexer.flush();
+        std::vector<token_t> tokens;
+        while (auto token = lexer.next_token()) {
+            tokens.push_back(std::move(*token));
+        }
+        return tokens;
+    }
+};
+
+TEST_F(aho_corasick_fixture, n_states)
+{
+    table_t table({
+        {"ada", symbol_t::symbol_0},
+        {"abd", symbol_t::symbol_1},
+        {"bacc", symbol_t::symbol_1},
+        {"adbc", symbol_t::symbol_0},
+    });
+
+    // root, a, ad, ada, ab, abd, adb, adbc, b, ba, bac, bacc
+    EXPECT_EQ(table.n_states(), static_cast<size_t>(12));
+}
+
+// failure links find lexemes that are suffixes of the current prefix
+TEST_F(aho_corasick_fixture, failure_transitions)
+{
+    table_t table({
+        {"abcd", symbol_t::symbol_0},
+        {"bc", symbol_t::symbol_1},
+    });
+
+    table_t::state_t state = 0;
+    state = table.next(state, 'a');
+    EXPECT_EQ(table.depth(state), static_cast<size_t>(1));
+    EXPECT_EQ(table.match_length(state), static_cast<size_t>(0));
+    state = table.next(state, 'b');
+    state = table.next(state, 'c');
+    EXPECT_EQ(table.depth(state), static_cast<size_t>(3));
+    EXPECT_EQ(table.match_length(state), static_cast<size_t>(2));   // "bc"
+    EXPECT_EQ(table.match_symbol(state), symbol_t::symbol_1);
+    state = table.next(state, 'x');
+    EXPECT_EQ(table.depth(state), static_cast<size_t>(0));
+    state = table.next(state, 'b');
+    state = table.next(state, 'c');
+    EXPECT_EQ(table.depth(state), static_cast<size_t>(2));
+    EXPECT_EQ(table.match_length(state), static_cast<size_t>(2));
+}
+
+TEST_F(aho_corasick_fixture, empty_string_throws)
+{
+    EXPECT_THROW(table_t({{"", symbol_t::symbol_0}}), std::invalid_argument);
+}
+
+// same tokens as LexerGeneric on ordinary source
+TEST_F(aho_corasick_fixture, lexer_equivalence)
+{
+    static constexpr const char* contents[] = {
+        "somecrazy1492text\nmvn2b",
+        "abc////",
+        "abc/////*!*/**/*",
+        "#include <core/lexer_trie.hpp> // some comment\n"
+        "\n"
+        "void f();",
+        "/*! @sdesc some\tdescription\n"
+        " * @tparam T type\n"
+        " * @param x value @return nothing @par @retur\n"
+        " */\n"
+        "template <class T>\n"
+        "struct A { class B; };\n"
+        "templat structure clas",
+    };
+
+    for (const char* content : contents) {
+        Lexer lexer;
+        auto ac_lexer = make_lexer();
+        const auto ac_tokens = lex(ac_lexer, content);
+
+        for (const char* c = content; *c; ++c) {
+            lexer.process(*c);
+        }
+        lexer.flush();
+
+        size_t i = 0;
+        while (auto token = lexer.next_token()) {
+            ASSERT_LT(i, ac_tokens.size());
+            EXPECT_EQ(token->name, ac_tokens[i].name);
+            EXPECT_EQ(token->content, ac_tokens[i].content);
+            ++i;
+        }
+        EXPECT_EQ(i, ac_tokens.size());
+    }
+}
+
+// a lexeme starting inside a failed partial match is still found
+TEST_F(aho_corasick_fixture, leftmost_longest)
+{
+    auto lexer = make_lexer();
+    const auto tokens = lex(lexer, "@struct");
+    ASSERT_EQ(tokens.size(), static_cast<size_t>(2));
+    EXPECT_EQ(tokens[0].name, Symbol::TEXT);
+    EXPECT_EQ(tokens[0].content, "@");
+    EXPECT_EQ(tokens[1].name, Symbol::STRUCT);
+}
+
+// chunked processing and whole-buffer tokenizing agree
+TEST_F(aho_corasick_fixture, chunk_tokenize)
+{
+    static constexpr const char* content =
+        "/// @sdesc a\n/*! @param x */\ntemplate <class T> struct S {};\n/@struc//*/**!";
+
+    auto lexer = make_lexer();
+    const auto expected = lex(lexer, content);
+
+    const std::string source(content);
+    for (size_t chunk_size = 1; chunk_size <= source.size(); ++chunk_size) {
+        std::vector<token_t> actual;
+        auto sink = [&](token_t&& t) { actual.push_back(std::move(t)); };
+        for (size_t i = 0; i < source.size(); i += chunk_size) {
+            lexer.process(std::string_view(source).substr(i, chunk_size), sink);
+        }
+        lexer.flush(sink);
+
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].name, expected[i].name);
+            EXPECT_EQ(actual[i].content, expected[i].content);
+        }
+    }
+
+    const auto stream = lexer.tokenize(source);
+    ASSERT_EQ(stream.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(stream[i].name, expected[i].name);
+        EXPECT_EQ(stream[i].content, expected[i].content);
+    }
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
@@ -0,0 +1,89 @@
+#include <core/lex/block_skipper.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct block_skipper_fixture : ::testing::Test
+{
+protected:
+    BlockSkipper skipper;
+
+    // number of chars consumed by skipper (up to and including the close brace)
+    // when str is fed in chunks of size n
+    size_t skip(const std::string& str, size_t n)
+    {
+        skipper.start();
+        size_t consumed = 0;
+        for (size_t i = 0; i < str.size() && !skipper.done(); i += n) {
+            const char* first = str.data() + i;
+            const char* last = str.data() + std::min(i + n, str.size());
+            consumed += skipper.find(first, last) - first;
+        }
+        return consumed;
+    }
+
+    // checks that the close brace is found right before "<end>" for every chunk size
+    void expect_end(const std::string& str)
+    {
+        const size_t expected = str.find("<end>");
+        ASSERT_NE(expected, std::string::npos);
+        for (size_t n = 1; n <= str.size(); ++n) {
+            EXPECT_EQ(skip(str, n), expected) << "chunk size " << n;
+            EXPECT_TRUE(skipper.done()) << "chunk size " << n;
+        }
+    }
+};
+
+TEST_F(block_skipper_fixture, flat)
+{
+    expect_end(" int x = 0; return x; }<end> int y; }");
+}
+
+TEST_F(block_skipper_fixture, nested)
+{
+    expect_end(" if (x) { y(); } else { for (;;) { z(); } } }<end> }");
+}
+
+TEST_F(block_skipper_fixture, comments)
+{
+    expect_end(" // } \n /* } */ /*/ } */ /** } **/ x; }<end>");
+}
+
+TEST_F(block_skipper_fixture, line_comment_continuation)
+{
+    expect_end(" // \\\n } \n }<end>");
+}
+
+TEST_F(block_skipper_fixture, strings)
+{
+    expect_end(" puts(\"}\"); puts(\"\\\"}\"); puts(\"\\\\\"); }<end>");
+}
+
+TEST_F(block_skipper_fixture, chars)
+{
+    expect_end(" c = '}'; c = '\\''; c = '\\\\'; c = u8'}'; }<end>");
+}
+
+TEST_F(block_skipper_fixture, digit_separators)
+{
+    expect_end(" x = 1'000'000; y = 0xFF'FF; }<end>");
+}
+
+TEST_F(block_skipper_fixture, unterminated_literal_ends_at_newline)
+{
+    expect_end(" x = \"}\n }<end>");
+}
+
+TEST_F(block_skipper_fixture, not_found)
+{
+    const std::string str = " { x; } // }";
+    EXPECT_EQ(skip(str, 3), str.size());
+    EXPECT_FALSE(skipper.done());
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
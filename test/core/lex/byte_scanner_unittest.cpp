@@ -0,0 +1,105 @@
+#include <core/lex/byte_scanner.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct byte_scanner_fixture : ::testing::Test
+{
+protected:
+    static byte_set_t make_set(const std::string& chars)
+    {
+        byte_set_t set = {};
+        for (char c : chars) {
+            set[static_cast<unsigned char>(c)] = true;
+        }
+        return set;
+    }
+
+    // position of first char in set computed one char at a time
+    static size_t find_expected(const std::string& str, const byte_set_t& set)
+    {
+        size_t i = 0;
+        for (; i < str.size(); ++i) {
+            if (set[static_cast<unsigned char>(str[i])]) {
+                break;
+            }
+        }
+        return i;
+    }
+};
+
+TEST_F(byte_scanner_fixture, find_empty_range)
+{
+    ByteScanner scanner(make_set("/*"));
+    const std::string str;
+    EXPECT_EQ(scanner.find(str.data(), str.data()), str.data());
+}
+
+TEST_F(byte_scanner_fixture, find_none)
+{
+    ByteScanner scanner(make_set("/*"));
+    const std::string str(100, 'a');
+    EXPECT_EQ(scanner.find(str.data(), str.data() + str.size()), str.data() + str.size());
+}
+
+TEST_F(byte_scanner_fixture, find_every_position)
+{
+    const byte_set_t set = make_set("\n\t ;#*{}<>/tcs@");
+    ByteScanner scanner(set);
+
+    // hit at every offset, including across SIMD block boundaries and in the scalar tail
+    for (size_t pos = 0; pos < 100; ++pos) {
+        std::string str(100, 'x');
+        str[pos] = '@';
+        const char* hit = scanner.find(str.data(), str.data() + str.size());
+        EXPECT_EQ(static_cast<size_t>(hit - str.data()), pos);
+    }
+}
+
+TEST_F(byte_scanner_fixture, find_first_of_many)
+{
+    const byte_set_t set = make_set("{};");
+    ByteScanner scanner(set);
+
+    const std::string str = "int main(void) { return 0; }";
+    EXPECT_EQ(static_cast<size_t>(scanner.find(str.data(), str.data() + str.size()) - str.data()),
+              find_expected(str, set));
+}
+
+TEST_F(byte_scanner_fixture, find_non_ascii)
+{
+    const std::string chars = "\xff\x80";
+    const byte_set_t set = make_set(chars);
+    ByteScanner scanner(set);
+
+    const std::string str = std::string(40, 'a') + "\x80" + std::string(5, 'a');
+    EXPECT_EQ(static_cast<size_t>(scanner.find(str.data(), str.data() + str.size()) - str.data()),
+              static_cast<size_t>(40));
+}
+
+// more than max_needles bytes in set falls back to scalar scanning
+TEST_F(byte_scanner_fixture, find_large_set)
+{
+    std::string chars;
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        chars.push_back(c);
+    }
+    for (char c = '0'; c <= '9'; ++c) {
+        chars.push_back(c);
+    }
+    const byte_set_t set = make_set(chars);
+    ByteScanner scanner(set);
+
+    const std::string str = std::string(37, 'a') + "Q";
+    EXPECT_EQ(static_cast<size_t>(scanner.find(str.data(), str.data() + str.size()) - str.data()),
+              find_expected(str, set));
+    EXPECT_TRUE(scanner.contains('7'));
+    EXPECT_FALSE(scanner.contains('a'));
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
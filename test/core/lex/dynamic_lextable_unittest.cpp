@@ -0,0 +1,182 @@
+#include <core/lex/dynamic_lextable.hpp>
+#include <core/lex/lexer.hpp>
+#include <core/utils/trie_base_fixture.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct dynamic_lextable_fixture : utils::trie_base_fixture
+{
+protected:
+    using table_t = DynamicLexTable<symbol_t>;
+
+    table_t make_table() const
+    {
+        return table_t({
+            {"ada", symbol_t::symbol_0},
+            {"abd", symbol_t::symbol_1},
+            {"bacc", symbol_t::symbol_1},
+            {"adbc", symbol_t::symbol_0},
+        });
+    }
+};
+
+TEST_F(dynamic_lextable_fixture, is_accept)
+{
+    table_t trie({{"a", symbol_t::symbol_0}, {"ab", symbol_t::symbol_1}});
+    EXPECT_TRUE(!trie.is_accept());
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+    EXPECT_EQ(*trie.get_symbol(), symbol_t::symbol_1);
+}
+
+TEST_F(dynamic_lextable_fixture, back_transition)
+{
+    table_t trie = make_table();
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('d', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+    EXPECT_EQ(trie.back_transition(), static_cast<size_t>(1));
+    EXPECT_TRUE(!trie.is_accept());
+    EXPECT_EQ(trie.back_transition(5), static_cast<size_t>(2)); // stops at root
+    EXPECT_TRUE(trie.is_reset());
+}
+
+TEST_F(dynamic_lextable_fixture, transition_fail_reset)
+{
+    table_t trie = make_table();
+    EXPECT_FALSE(trie.transition('c', [](){})); // no transition
+    EXPECT_TRUE(trie.is_reset());
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_FALSE(trie.transition('b', [](){})); // no transition
+    EXPECT_FALSE(static_cast<bool>(trie.get_symbol()));
+    trie.reset();
+    EXPECT_TRUE(trie.is_reset());
+}
+
+TEST_F(dynamic_lextable_fixture, n_states_lead_bytes)
+{
+    table_t trie = make_table();
+
+    // root, a, ad, ada, ab, abd, adb, adbc, b, ba, bac, bacc
+    EXPECT_EQ(trie.n_states(), static_cast<size_t>(12));
+
+    const byte_set_t lead = trie.lead_bytes();
+    for (size_t c = 0; c < lead.size(); ++c) {
+        EXPECT_EQ(lead[c], c == 'a' || c == 'b');
+    }
+}
+
+// copies share the table but walk independently
+TEST_F(dynamic_lextable_fixture, copy)
+{
+    table_t trie = make_table();
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    table_t copy = trie;
+    copy.reset();
+    EXPECT_TRUE(copy.transition('b', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('d', [](){})); // transition successful
+}
+
+TEST_F(dynamic_lextable_fixture, duplicate_last_wins)
+{
+    table_t trie({{"ab", symbol_t::symbol_0}, {"ab", symbol_t::symbol_1}});
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_EQ(*trie.get_symbol(), symbol_t::symbol_1);
+    EXPECT_EQ(trie.n_states(), static_cast<size_t>(3));
+}
+
+TEST_F(dynamic_lextable_fixture, empty_string_throws)
+{
+    EXPECT_THROW(table_t({{"", symbol_t::symbol_0}}), std::invalid_argument);
+}
+
+// lexer with the default runtime table must produce exactly the same tokens
+// as the compile-time lexer on anything without extra tags
+TEST_F(dynamic_lextable_fixture, lexer_equivalence)
+{
+    static constexpr const char* contents[] = {
+        "somecrazy1492text\nmvn2b",
+        "abc/////*!*/**/*",
+        "/*! @sdesc some\tdescription\n"
+        " * @tparam T type\n"
+        " * @param x value @return nothing @par @retur\n"
+        " */\n"
+        "template <class T>\n"
+        "struct A { class B; };\n"
+        "templat structure clas",
+    };
+
+    const dynamic_lextable_t table = make_dynamic_lextable();
+    for (const char* content : contents) {
+        Lexer lexer;
+        DynamicLexer dynamic_lexer(table);
+
+        for (const char* c = content; *c; ++c) {
+            lexer.process(*c);
+            dynamic_lexer.process(*c);
+        }
+        lexer.flush();
+        dynamic_lexer.flush();
+
+        auto token = lexer.next_token();
+        auto dynamic_token = dynamic_lexer.next_token();
+        while (token && dynamic_token) {
+            EXPECT_EQ(token->name, dynamic_token->name);
+            EXPECT_EQ(token->content, dynamic_token->content);
+            token = lexer.next_token();
+            dynamic_token = dynamic_lexer.next_token();
+        }
+        EXPECT_FALSE(static_cast<bool>(token));
+        EXPECT_FALSE(static_cast<bool>(dynamic_token));
+    }
+}
+
+// tags from tag_set and extra tags are lexed as TAG with the lexeme as content
+TEST_F(dynamic_lextable_fixture, lexer_tags)
+{
+    static constexpr const char* content = "@section A @note B @param";
+
+    DynamicLexer lexer(make_dynamic_lextable({"note", "param"}));
+    for (const char* c = content; *c; ++c) {
+        lexer.process(*c);
+    }
+    lexer.flush();
+
+    std::vector<Token<Symbol>> tokens;
+    while (auto token = lexer.next_token()) {
+        if (token->name != Symbol::WHITESPACE) {
+            tokens.push_back(std::move(*token));
+        }
+    }
+
+    ASSERT_EQ(tokens.size(), static_cast<size_t>(5));
+    EXPECT_EQ(tokens[0].name, Symbol::TAG);
+    EXPECT_EQ(tokens[0].content, "@section");
+    EXPECT_EQ(tokens[1].content, "A");
+    EXPECT_EQ(tokens[2].name, Symbol::TAG);
+    EXPECT_EQ(tokens[2].content, "@note");
+    EXPECT_EQ(tokens[3].content, "B");
+    EXPECT_EQ(tokens[4].name, Symbol::PARAM);
+    EXPECT_TRUE(tokens[4].content.empty());
+
+    // whole-buffer path agrees
+    std::vector<TokenView<Symbol>> views;
+    lexer.tokenize(content, [&](TokenView<Symbol>&& t) {
+        if (t.name == Symbol::TAG) {
+            views.push_back(t);
+        }
+    });
+    ASSERT_EQ(views.size(), static_cast<size_t>(2));
+    EXPECT_EQ(views[0].content, "@section");
+    EXPECT_EQ(views[1].content, "@note");
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
@@ -1,5 +1,6 @@
 #include <core/lex/lexer.hpp>
 #include <gtest/gtest.h>
+#include <vector>
 
 namespace docgen {
 namespace core {
@@ -798,6 +799,505 @@ TEST_F(lexer_fixture, lexer_test_1_tagname_comments)
     EXPECT_FALSE(static_cast<bool>(token));
 }
 
+////////////////////////////////////////////////////////////////////
+// Chunked Processing TESTS
+////////////////////////////////////////////////////////////////////
+
+static constexpr const char* chunk_content =
+    "#include <gtest/gtest.h> // comment\n"
+    "/*! @sdesc some description\n"
+    " * @tparam T type @param x value\n"
+    " */\n"
+    "template <class T>\n"
+    "struct A { void f(); }; ////\n"
+    ;
+
+// chunks of every size produce the same tokens as processing character by character
+TEST_F(lexer_fixture, lexer_chunk_sink)
+{
+    std::vector<token_t> expected;
+    setup_lexer(chunk_content);
+    while ((token = lexer.next_token())) {
+        expected.push_back(std::move(*token));
+    }
+
+    const std::string_view str(chunk_content);
+    for (size_t chunk_size = 1; chunk_size <= str.size(); ++chunk_size) {
+        std::vector<token_t> actual;
+        auto sink = [&](token_t&& t) { actual.push_back(std::move(t)); };
+        for (size_t i = 0; i < str.size(); i += chunk_size) {
+            lexer.process(str.substr(i, chunk_size), sink);
+        }
+        lexer.flush(sink);
+
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].name, expected[i].name);
+            EXPECT_EQ(actual[i].content, expected[i].content);
+        }
+    }
+}
+
+// chunks without a sink leave tokens in the queue
+TEST_F(lexer_fixture, lexer_chunk_queue)
+{
+    lexer.process("abc ");
+    lexer.process("{");
+    lexer.flush();
+
+    token = lexer.next_token();
+    EXPECT_EQ(token->name, symbol_t::TEXT);
+	EXPECT_EQ(token->content, "abc");
+
+    token = lexer.next_token();
+    EXPECT_EQ(token->name, symbol_t::WHITESPACE);
+	EXPECT_EQ(token->content, "");
+
+    token = lexer.next_token();
+    EXPECT_EQ(token->name, symbol_t::OPEN_BRACE);
+	EXPECT_EQ(token->content, "");
+
+    // check that there are no more tokens
+    token = lexer.next_token();
+    EXPECT_FALSE(static_cast<bool>(token));
+}
+
+////////////////////////////////////////////////////////////////////
+// Zero-copy Tokenize TESTS
+////////////////////////////////////////////////////////////////////
+
+// tokenizing a whole buffer produces the same tokens as processing it
+// and TEXT content refers into the buffer
+TEST_F(lexer_fixture, lexer_tokenize_view)
+{
+    static constexpr const char* contents[] = {
+        chunk_content,
+        "abc////",
+        "abc/////*!*/**/*",
+        "templat structure clas @para @tparam",
+        "",
+    };
+
+    for (const char* content : contents) {
+        std::vector<token_t> expected;
+        setup_lexer(content);
+        while ((token = lexer.next_token())) {
+            expected.push_back(std::move(*token));
+        }
+
+        const std::string source(content);
+        std::vector<Lexer::token_view_t> actual;
+        lexer.tokenize(source, [&](Lexer::token_view_t&& t) { actual.push_back(t); });
+
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i].name, expected[i].name);
+            EXPECT_EQ(actual[i].content, expected[i].content);
+            if (actual[i].name == symbol_t::TEXT) {
+                EXPECT_GE(actual[i].content.data(), source.data());
+                EXPECT_LE(actual[i].content.data() + actual[i].content.size(),
+                          source.data() + source.size());
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////
+// Maximal Munch TESTS
+////////////////////////////////////////////////////////////////////
+
+// long runs of near-miss prefixes resolve to the same tokens
+// as lexing them one lexeme at a time
+TEST_F(lexer_fixture, lexer_near_miss_runs)
+{
+    static constexpr size_t n = 1 << 12;
+
+    // every "///" is a lexeme, leftover is a single forward slash
+    setup_lexer(std::string(3 * n + 1, '/').c_str());
+    for (size_t i = 0; i < n; ++i) {
+        token = lexer.next_token();
+        EXPECT_EQ(*token, token_t(symbol_t::BEGIN_SLINE_COMMENT));
+    }
+    token = lexer.next_token();
+    EXPECT_EQ(*token, token_t(symbol_t::FORWARD_SLASH));
+    token = lexer.next_token();
+    EXPECT_FALSE(static_cast<bool>(token));
+
+    // "@para" never completes "@param", so everything is text
+    std::string content;
+    for (size_t i = 0; i < n; ++i) {
+        content += "@para";
+    }
+    setup_lexer(content.c_str());
+    token = lexer.next_token();
+    EXPECT_EQ(*token, token_t(symbol_t::TEXT, std::string(content)));
+    token = lexer.next_token();
+    EXPECT_FALSE(static_cast<bool>(token));
+}
+
+////////////////////////////////////////////////////////////////////
+// Snapshot TESTS
+////////////////////////////////////////////////////////////////////
+
+// restoring a snapshot taken at any offset into a fresh lexer
+// resolves the same tokens as lexing without interruption
+TEST_F(lexer_fixture, lexer_snapshot_restore)
+{
+    static constexpr const char* content =
+        "#include <gtest/gtest.h> // some comment\n"
+        "/// @sdesc some short description\n"
+        "/*! @param x some param @tparam T @return // @para */\n"
+        "template <class T> struct A {};\n"
+        ;
+    const std::string str(content);
+
+    setup_lexer(content);
+    std::vector<token_t> expected;
+    while ((token = lexer.next_token())) {
+        expected.push_back(std::move(*token));
+    }
+
+    for (size_t i = 0; i <= str.size(); ++i) {
+        std::vector<token_t> actual;
+        auto sink = [&](token_t&& t) { actual.push_back(std::move(t)); };
+
+        Lexer first;
+        first.process(std::string_view(str).substr(0, i), sink);
+        EXPECT_EQ(first.offset(), i);
+        const auto snapshot = first.snapshot();
+
+        Lexer second;
+        second.restore(snapshot);
+        EXPECT_EQ(second.offset(), i);
+        second.process(std::string_view(str).substr(i), sink);
+        second.flush(sink);
+        EXPECT_EQ(second.offset(), str.size());
+
+        ASSERT_EQ(actual.size(), expected.size()) << "split at " << i;
+        for (size_t j = 0; j < expected.size(); ++j) {
+            EXPECT_EQ(actual[j], expected[j]) << "split at " << i;
+        }
+    }
+}
+
+// restore discards resolved tokens and overrides any state
+TEST_F(lexer_fixture, lexer_snapshot_restore_overrides)
+{
+    Lexer other;
+    const auto snapshot = other.snapshot();
+
+    lexer.process("text /");
+    lexer.restore(snapshot);
+    EXPECT_TRUE(lexer.is_quiet());
+    EXPECT_EQ(lexer.offset(), 0u);
+    token = lexer.next_token();
+    EXPECT_FALSE(static_cast<bool>(token));
+
+    lexer.process("//");
+    lexer.flush();
+    token = lexer.next_token();
+    EXPECT_EQ(*token, token_t(symbol_t::BEGIN_NLINE_COMMENT));
+    token = lexer.next_token();
+    EXPECT_FALSE(static_cast<bool>(token));
+}
+
+// quiet only while no lexeme is in progress
+TEST_F(lexer_fixture, lexer_is_quiet)
+{
+    EXPECT_TRUE(lexer.is_quiet());
+    lexer.process("123");
+    EXPECT_TRUE(lexer.is_quiet());
+    lexer.process('\n');       // may still be followed by a longer lexeme
+    EXPECT_FALSE(lexer.is_quiet());
+    lexer.process('9');
+    EXPECT_TRUE(lexer.is_quiet());
+    lexer.process('/');
+    EXPECT_FALSE(lexer.is_quiet());
+    lexer.flush();
+    EXPECT_TRUE(lexer.is_quiet());
+}
+
+////////////////////////////////////////////////////////////////////
+// Block Skipping TESTS
+////////////////////////////////////////////////////////////////////
+
+// every block is skipped down to its close brace
+// no matter how input is split into chunks
+TEST_F(lexer_fixture, lexer_skip_block)
+{
+    const std::string content =
+        "void f() { if (x) { \"}\"; } // }\n }\n"
+        "struct A {};";
+    const std::vector<token_t> expected = {
+        token_t(symbol_t::TEXT, "void"),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::TEXT, "f()"),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::OPEN_BRACE),
+        token_t(symbol_t::CLOSE_BRACE),
+        token_t(symbol_t::NEWLINE),
+        token_t(symbol_t::STRUCT),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::TEXT, "A"),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::OPEN_BRACE),
+        token_t(symbol_t::CLOSE_BRACE),
+        token_t(symbol_t::SEMICOLON),
+    };
+
+    for (size_t n = 1; n <= content.size(); ++n) {
+        Lexer lexer;
+        std::vector<token_t> actual;
+        auto sink = [&](token_t&& t) {
+            // skip every block but the last
+            if (t.name == symbol_t::OPEN_BRACE && actual.size() < 5) {
+                EXPECT_TRUE(lexer.skip_block());
+            }
+            actual.push_back(std::move(t));
+        };
+        for (size_t i = 0; i < content.size(); i += n) {
+            lexer.process(std::string_view(content).substr(i, n), sink);
+        }
+        lexer.flush(sink);
+
+        ASSERT_EQ(actual.size(), expected.size()) << "chunk size " << n;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i], expected[i]) << "chunk size " << n;
+        }
+    }
+}
+
+// same as above when retrieving tokens one at a time
+TEST_F(lexer_fixture, lexer_skip_block_next_token)
+{
+    std::vector<token_t> actual;
+    for (char c : std::string("a{b{}c}d")) {
+        lexer.process(c);
+        while ((token = lexer.next_token())) {
+            if (token->name == symbol_t::OPEN_BRACE) {
+                EXPECT_TRUE(lexer.skip_block());
+            }
+            actual.push_back(std::move(*token));
+        }
+    }
+    lexer.flush();
+    while ((token = lexer.next_token())) {
+        actual.push_back(std::move(*token));
+    }
+
+    ASSERT_EQ(actual.size(), 4u);
+    EXPECT_EQ(actual[0], token_t(symbol_t::TEXT, "a"));
+    EXPECT_EQ(actual[1], token_t(symbol_t::OPEN_BRACE));
+    EXPECT_EQ(actual[2], token_t(symbol_t::CLOSE_BRACE));
+    EXPECT_EQ(actual[3], token_t(symbol_t::TEXT, "d"));
+}
+
+// only honored right after an open brace
+TEST_F(lexer_fixture, lexer_skip_block_ignored)
+{
+    EXPECT_FALSE(lexer.skip_block());
+    lexer.process("{ x;");
+    token = lexer.next_token();
+    EXPECT_EQ(*token, token_t(symbol_t::OPEN_BRACE));
+    EXPECT_FALSE(lexer.skip_block());
+
+    // open brace at the very end of input
+    Lexer other;
+    std::vector<token_t> actual;
+    auto sink = [&](token_t&& t) { 
+        EXPECT_FALSE(other.skip_block());
+        actual.push_back(std::move(t)); 
+    };
+    other.process("{", sink);
+    other.flush(sink);
+    ASSERT_EQ(actual.size(), 1u);
+    EXPECT_EQ(actual[0], token_t(symbol_t::OPEN_BRACE));
+}
+
+// whole-buffer tokenizing skips blocks from within sink as well
+TEST_F(lexer_fixture, lexer_skip_block_tokenize)
+{
+    const std::string source = "a { /* } */ { } } b { c";
+    std::vector<Lexer::token_view_t> actual;
+    lexer.tokenize(source, [&](Lexer::token_view_t&& t) {
+        if (t.name == symbol_t::OPEN_BRACE) {
+            EXPECT_TRUE(lexer.skip_block());
+        }
+        actual.push_back(t);
+    });
+
+    const std::vector<Lexer::token_view_t> expected = {
+        {symbol_t::TEXT, "a"},
+        {symbol_t::WHITESPACE, ""},
+        {symbol_t::OPEN_BRACE, ""},
+        {symbol_t::CLOSE_BRACE, ""},
+        {symbol_t::WHITESPACE, ""},
+        {symbol_t::TEXT, "b"},
+        {symbol_t::WHITESPACE, ""},
+        {symbol_t::OPEN_BRACE, ""},
+    };
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].name, expected[i].name) << "token " << i;
+        EXPECT_EQ(actual[i].content, expected[i].content) << "token " << i;
+    }
+}
+
+// a snapshot taken while skipping continues skipping
+TEST_F(lexer_fixture, lexer_skip_block_snapshot)
+{
+    std::vector<token_t> actual;
+    auto sink = [&](token_t&& t) { actual.push_back(std::move(t)); };
+
+    Lexer first;
+    first.process("{", sink);
+    first.process(" \"}", [&](token_t&& t) {
+        if (t.name == symbol_t::OPEN_BRACE) {
+            EXPECT_TRUE(first.skip_block());
+        }
+        sink(std::move(t));
+    });
+    EXPECT_FALSE(first.is_quiet());
+
+    Lexer second;
+    second.restore(first.snapshot());
+    second.process("\" } x", sink);
+    second.flush(sink);
+
+    ASSERT_EQ(actual.size(), 4u);
+    EXPECT_EQ(actual[0], token_t(symbol_t::OPEN_BRACE));
+    EXPECT_EQ(actual[1], token_t(symbol_t::CLOSE_BRACE));
+    EXPECT_EQ(actual[2], token_t(symbol_t::WHITESPACE));
+    EXPECT_EQ(actual[3], token_t(symbol_t::TEXT, "x"));
+}
+
+TEST_F(lexer_fixture, lexer_want_text)
+{
+    std::vector<token_t> actual;
+    Lexer lexer;
+    auto sink = [&](token_t&& t) {
+        // content is wanted only after a semicolon
+        lexer.want_text(t.name == symbol_t::SEMICOLON);
+        actual.push_back(std::move(t));
+    };
+    lexer.process("abc;def{ghi", sink);
+    lexer.flush(sink);
+
+    ASSERT_EQ(actual.size(), 5u);
+    EXPECT_EQ(actual[0], token_t(symbol_t::TEXT, "abc"));
+    EXPECT_EQ(actual[0].content, "abc");
+    EXPECT_EQ(actual[1], token_t(symbol_t::SEMICOLON));
+    EXPECT_EQ(actual[2], token_t(symbol_t::TEXT, "def"));
+    EXPECT_EQ(actual[2].content, "def");
+    EXPECT_EQ(actual[3], token_t(symbol_t::OPEN_BRACE));
+    EXPECT_EQ(actual[4], token_t(symbol_t::TEXT));
+    // 'g' was read to resolve the open brace, the rest was not copied
+    EXPECT_EQ(actual[4].content, "g");
+}
+
+TEST_F(lexer_fixture, lexer_want_text_snapshot)
+{
+    Lexer first;
+    first.want_text(false);
+    first.process("abc");
+
+    Lexer second;
+    second.restore(first.snapshot());
+    second.flush();
+
+    auto token = second.next_token();
+    ASSERT_TRUE(static_cast<bool>(token));
+    EXPECT_EQ(*token, token_t(symbol_t::TEXT));
+    EXPECT_FALSE(static_cast<bool>(second.next_token()));
+}
+
+TEST_F(lexer_fixture, lexer_coalesce)
+{
+    std::vector<token_t> actual;
+    auto sink = [&](token_t&& t) { actual.push_back(std::move(t)); };
+    Lexer lexer;
+    lexer.coalesce(true);
+    lexer.process(" \t", sink);
+    lexer.process(" ;\n\n", sink);
+    lexer.process("\n x  ", sink);
+    lexer.flush(sink);
+
+    ASSERT_EQ(actual.size(), 6u);
+    EXPECT_EQ(actual[0], token_t(symbol_t::WHITESPACE));
+    EXPECT_EQ(actual[0].content, " \t ");
+    EXPECT_EQ(actual[1], token_t(symbol_t::SEMICOLON));
+    EXPECT_EQ(actual[2], token_t(symbol_t::NEWLINE));
+    EXPECT_EQ(actual[2].content, "\n\n\n");
+    EXPECT_EQ(actual[3], token_t(symbol_t::WHITESPACE));
+    EXPECT_EQ(actual[3].content, " ");
+    EXPECT_EQ(actual[4], token_t(symbol_t::TEXT, "x"));
+    EXPECT_EQ(actual[5], token_t(symbol_t::WHITESPACE));
+    EXPECT_EQ(actual[5].content, "  ");
+}
+
+TEST_F(lexer_fixture, lexer_coalesce_tokenize)
+{
+    std::vector<std::pair<symbol_t, std::string_view>> actual;
+    Lexer lexer;
+    lexer.coalesce(true);
+    lexer.tokenize("  a\t\t\n\n", [&](const Lexer::token_view_t& t) {
+        actual.emplace_back(t.name, t.content);
+    });
+
+    ASSERT_EQ(actual.size(), 4u);
+    EXPECT_EQ(actual[0].first, symbol_t::WHITESPACE);
+    EXPECT_EQ(actual[0].second, "  ");
+    EXPECT_EQ(actual[1].first, symbol_t::TEXT);
+    EXPECT_EQ(actual[1].second, "a");
+    EXPECT_EQ(actual[2].first, symbol_t::WHITESPACE);
+    EXPECT_EQ(actual[2].second, "\t\t");
+    EXPECT_EQ(actual[3].first, symbol_t::NEWLINE);
+    EXPECT_EQ(actual[3].second, "\n\n");
+}
+
+TEST_F(lexer_fixture, lexer_coalesce_snapshot)
+{
+    std::vector<token_t> actual;
+    auto sink = [&](token_t&& t) { actual.push_back(std::move(t)); };
+
+    Lexer first;
+    first.coalesce(true);
+    first.process("a  ", sink);
+
+    Lexer second;
+    second.coalesce(true);
+    second.restore(first.snapshot());
+    second.process(" b", sink);
+    second.flush(sink);
+
+    ASSERT_EQ(actual.size(), 3u);
+    EXPECT_EQ(actual[0], token_t(symbol_t::TEXT, "a"));
+    EXPECT_EQ(actual[1], token_t(symbol_t::WHITESPACE));
+    EXPECT_EQ(actual[1].content, "   ");
+    EXPECT_EQ(actual[2], token_t(symbol_t::TEXT, "b"));
+}
+
+TEST_F(lexer_fixture, lexer_use_swar)
+{
+    using token_list_t = std::vector<std::pair<symbol_t, std::string>>;
+    const std::string source =
+        "/// @tparam T type\n"
+        "template <class T>\n"
+        "struct templates; /*! @return x */ classy @retur @param\n"
+        "// templat";
+
+    auto lex = [&source](bool use_swar) {
+        token_list_t tokens;
+        DynamicLexer lexer(make_dynamic_lextable());
+        lexer.use_swar(use_swar);
+        lexer.tokenize(source, [&](const DynamicLexer::token_view_t& t) {
+            tokens.emplace_back(t.name, std::string(t.content));
+        });
+        return tokens;
+    };
+    EXPECT_EQ(lex(true), lex(false));
+}
+
 } // namespace lex
 } // namespace core
 } // namespace docgen
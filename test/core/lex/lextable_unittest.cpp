@@ -0,0 +1,256 @@
+#include <core/lex/lextable.hpp>
+#include <core/lex/lexer.hpp>
+#include <core/utils/trie_base_fixture.hpp>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct lextable_fixture : utils::trie_base_fixture
+{};
+
+TEST_F(lextable_fixture, is_accept)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>
+    >;
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+
+    EXPECT_TRUE(!trie.is_accept());
+}
+
+TEST_F(lextable_fixture, transition_depth_1)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>
+    >;
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+}
+
+TEST_F(lextable_fixture, transition_depth_2)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>
+    >;
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+}
+
+TEST_F(lextable_fixture, back_transition_once)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>
+    >;
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+    EXPECT_EQ(trie.back_transition(), static_cast<size_t>(1)); 
+    EXPECT_TRUE(!trie.is_accept());
+}
+
+TEST_F(lextable_fixture, back_transition_twice)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>
+    >;
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+
+    EXPECT_TRUE(!trie.is_accept());
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_TRUE(trie.is_accept());
+    EXPECT_EQ(trie.back_transition(2), static_cast<size_t>(2)); 
+    EXPECT_TRUE(!trie.is_accept());
+}
+
+TEST_F(lextable_fixture, is_reset_true)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a', 'd', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b', 'd'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a', 'c', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'a', 'd', 'b', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>
+    >;
+
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+
+    EXPECT_TRUE(trie.is_reset());
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(!trie.is_reset());
+    EXPECT_TRUE(trie.transition('d', [](){})); // transition successful
+    EXPECT_TRUE(!trie.is_reset());
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(!trie.is_reset());
+    EXPECT_EQ(trie.back_transition(3), static_cast<size_t>(3));
+    EXPECT_TRUE(trie.is_reset());
+}
+
+TEST_F(lextable_fixture, reset)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a', 'd', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b', 'd'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a', 'c', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'a', 'd', 'b', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>
+    >;
+
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+    
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    trie.reset(); 
+    EXPECT_TRUE(trie.is_reset());
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+}
+
+TEST_F(lextable_fixture, get_symbol)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a', 'd', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b', 'd'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a', 'c', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'a', 'd', 'b', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>
+    >;
+
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+    
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('d', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_EQ(*(trie.get_symbol()), symbol_t::symbol_0);
+
+    trie.back_transition();
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('c', [](){})); // transition successful
+    EXPECT_EQ(*trie.get_symbol(), symbol_t::symbol_0);
+
+    trie.back_transition(3);
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('d', [](){})); // transition successful
+    EXPECT_EQ(*trie.get_symbol(), symbol_t::symbol_1);
+
+    trie.back_transition(3);
+    EXPECT_TRUE(trie.transition('b', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('c', [](){})); // transition successful
+    EXPECT_TRUE(trie.transition('c', [](){})); // transition successful
+    EXPECT_EQ(*trie.get_symbol(), symbol_t::symbol_1);
+}
+
+TEST_F(lextable_fixture, n_states)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a', 'd', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b', 'd'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a', 'c', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'a', 'd', 'b', 'c'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>
+    >;
+
+    using param_t = trie_params_t<list_t>;
+
+    // root, a, ad, ada, ab, abd, adb, adbc, b, ba, bac, bacc
+    EXPECT_EQ(LexTable<param_t>::n_states, static_cast<size_t>(12));
+}
+
+TEST_F(lextable_fixture, transition_fail)
+{
+    using namespace utils;
+    using list_t = typelist<
+        typelist<valuelist<char, 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_0>>,
+        typelist<valuelist<char, 'a', 'b'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>,
+        typelist<valuelist<char, 'b', 'a'>, std::integral_constant<symbol_t, symbol_t::symbol_1>>
+    >;
+    using param_t = trie_params_t<list_t>;
+    LexTable<param_t> trie;
+
+    EXPECT_FALSE(trie.transition('c', [](){})); // no transition
+    EXPECT_TRUE(trie.is_reset());
+    EXPECT_TRUE(trie.transition('a', [](){})); // transition successful
+    EXPECT_FALSE(trie.transition('a', [](){})); // no transition
+    EXPECT_EQ(*trie.get_symbol(), symbol_t::symbol_0);
+    EXPECT_EQ(trie.back_transition(5), static_cast<size_t>(1)); // stops at root
+    EXPECT_TRUE(trie.is_reset());
+}
+
+// LexerGeneric with LexTable must produce exactly the same tokens as with LexTrie.
+TEST_F(lextable_fixture, lexer_equivalence)
+{
+    static constexpr const char* contents[] = {
+        "somecrazy1492text\nmvn2b",
+        "abc////",
+        "abc/////*!*/**/*",
+        "#include <core/lexer_trie.hpp> // some comment\n"
+        "\n"
+        "void f();",
+        "/*! @sdesc some\tdescription\n"
+        " * @tparam T type\n"
+        " * @param x value @return nothing @par @retur\n"
+        " */\n"
+        "template <class T>\n"
+        "struct A { class B; };\n"
+        "templat structure clas",
+    };
+
+    for (const char* content : contents) {
+        Lexer lexer_trie;
+        LexerGeneric<lextable_t> lexer_table;
+
+        for (const char* c = content; *c; ++c) {
+            lexer_trie.process(*c);
+            lexer_table.process(*c);
+        }
+        lexer_trie.flush();
+        lexer_table.flush();
+
+        auto token_trie = lexer_trie.next_token();
+        auto token_table = lexer_table.next_token();
+        while (token_trie && token_table) {
+            EXPECT_EQ(token_trie->name, token_table->name);
+            EXPECT_EQ(token_trie->content, token_table->content);
+            token_trie = lexer_trie.next_token();
+            token_table = lexer_table.next_token();
+        }
+        EXPECT_FALSE(static_cast<bool>(token_trie));
+        EXPECT_FALSE(static_cast<bool>(token_table));
+    }
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
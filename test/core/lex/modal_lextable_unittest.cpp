@@ -0,0 +1,207 @@
+#include <core/lex/modal_lextable.hpp>
+#include <core/lex/lexer.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct modal_lextable_fixture : ::testing::Test
+{
+protected:
+    using token_t = ModalLexer::token_t;
+    using symbol_t = ModalLexer::symbol_t;
+
+    static std::vector<token_t> lex(ModalLexer& lexer, std::string_view content)
+    {
+        std::vector<token_t> tokens;
+        auto sink = [&](token_t&& t) { tokens.push_back(std::move(t)); };
+        lexer.process(content, sink);
+        lexer.flush(sink);
+        return tokens;
+    }
+
+    static std::vector<token_t> lex(std::string_view content)
+    {
+        ModalLexer lexer;
+        return lex(lexer, content);
+    }
+};
+
+// comment openers and closers switch mode
+TEST_F(modal_lextable_fixture, on_symbol)
+{
+    modal_lextable_t table;
+    EXPECT_EQ(table.mode(), LexMode::CODE);
+
+    table.on_symbol(Symbol::NEWLINE);
+    EXPECT_EQ(table.mode(), LexMode::CODE);
+    table.on_symbol(Symbol::BEGIN_SLINE_COMMENT);
+    EXPECT_EQ(table.mode(), LexMode::DOC_LINE);
+    table.on_symbol(Symbol::END_BLOCK_COMMENT);
+    EXPECT_EQ(table.mode(), LexMode::DOC_LINE);
+    table.on_symbol(Symbol::NEWLINE);
+    EXPECT_EQ(table.mode(), LexMode::CODE);
+
+    table.on_symbol(Symbol::BEGIN_SBLOCK_COMMENT);
+    EXPECT_EQ(table.mode(), LexMode::DOC_BLOCK);
+    table.on_symbol(Symbol::NEWLINE);
+    EXPECT_EQ(table.mode(), LexMode::DOC_BLOCK);
+    table.on_symbol(Symbol::END_BLOCK_COMMENT);
+    EXPECT_EQ(table.mode(), LexMode::CODE);
+
+    table.on_symbol(Symbol::BEGIN_NLINE_COMMENT);
+    EXPECT_EQ(table.mode(), LexMode::LINE_COMMENT);
+    table.on_symbol(Symbol::NEWLINE);
+    EXPECT_EQ(table.mode(), LexMode::CODE);
+
+    table.on_symbol(Symbol::BEGIN_NBLOCK_COMMENT);
+    EXPECT_EQ(table.mode(), LexMode::BLOCK_COMMENT);
+    table.on_symbol(Symbol::END_BLOCK_COMMENT);
+    EXPECT_EQ(table.mode(), LexMode::CODE);
+}
+
+// every mode only starts lexemes with the bytes that matter to it
+TEST_F(modal_lextable_fixture, lead_bytes)
+{
+    modal_lextable_t table;
+    EXPECT_TRUE(table.scanner().contains('c'));
+    EXPECT_FALSE(table.scanner().contains('@'));
+
+    table.set_mode(LexMode::DOC_LINE);
+    EXPECT_FALSE(table.scanner().contains('c'));
+    EXPECT_TRUE(table.scanner().contains('@'));
+    EXPECT_TRUE(table.scanner().contains(' '));
+
+    table.set_mode(LexMode::LINE_COMMENT);
+    for (int c = 0; c < 256; ++c) {
+        EXPECT_EQ(table.scanner().contains(static_cast<char>(c)), c == '\n');
+    }
+
+    table.set_mode(LexMode::BLOCK_COMMENT);
+    for (int c = 0; c < 256; ++c) {
+        EXPECT_EQ(table.scanner().contains(static_cast<char>(c)), c == '\n' || c == '*');
+    }
+}
+
+// copies share tables but keep their own mode and state
+TEST_F(modal_lextable_fixture, copy_state_is_independent)
+{
+    modal_lextable_t table;
+    EXPECT_TRUE(table.transition('/', []() {}));
+    EXPECT_FALSE(table.is_reset());
+
+    modal_lextable_t copy = table;
+    copy.set_mode(LexMode::BLOCK_COMMENT);
+    EXPECT_TRUE(copy.is_reset());
+    EXPECT_TRUE(copy.transition('*', []() {}));
+    EXPECT_TRUE(copy.transition('/', []() {}));
+    ASSERT_TRUE(copy.get_symbol().has_value());
+    EXPECT_EQ(*copy.get_symbol(), Symbol::END_BLOCK_COMMENT);
+
+    EXPECT_EQ(table.mode(), LexMode::CODE);
+    EXPECT_FALSE(table.is_reset());
+    EXPECT_TRUE(table.transition('/', []() {}));
+    EXPECT_TRUE(table.transition('/', []() {}));
+    ASSERT_TRUE(table.get_symbol().has_value());
+    EXPECT_EQ(*table.get_symbol(), Symbol::BEGIN_SLINE_COMMENT);
+    EXPECT_EQ(table.back_transition(5), static_cast<size_t>(3));
+    EXPECT_TRUE(table.is_reset());
+}
+
+// plain comment bodies become text, keywords are only lexed in code
+// and tags only in doc comments
+TEST_F(modal_lextable_fixture, lexer_modes)
+{
+    const auto tokens = lex(
+            "@param class // a {b}; class\n"
+            "/// @param classname {x}\n"
+            "/* struct; */template"
+            );
+
+    const std::vector<token_t> expected = {
+        token_t(symbol_t::TEXT, "@param"),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::CLASS),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::BEGIN_NLINE_COMMENT),
+        token_t(symbol_t::TEXT, " a {b}; class"),
+        token_t(symbol_t::NEWLINE),
+        token_t(symbol_t::BEGIN_SLINE_COMMENT),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::PARAM),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::TEXT, "classname"),
+        token_t(symbol_t::WHITESPACE),
+        token_t(symbol_t::OPEN_BRACE),
+        token_t(symbol_t::TEXT, "x"),
+        token_t(symbol_t::CLOSE_BRACE),
+        token_t(symbol_t::NEWLINE),
+        token_t(symbol_t::BEGIN_NBLOCK_COMMENT),
+        token_t(symbol_t::TEXT, " struct; "),
+        token_t(symbol_t::END_BLOCK_COMMENT),
+        token_t(symbol_t::TEMPLATE),
+    };
+
+    ASSERT_EQ(tokens.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(tokens[i], expected[i]) << "token " << i;
+    }
+}
+
+// chunked processing, whole-buffer tokenizing and
+// restoring snapshots all switch modes at the same places
+TEST_F(modal_lextable_fixture, lexer_paths_agree)
+{
+    const std::string content =
+        "#include <a> // b\n"
+        "/*! @tparam T\n * {T}\n */\n"
+        "template <class T>\n"
+        "struct A { /* } */ int x; }; /// @sdesc done\n";
+
+    const auto expected = lex(content);
+
+    ModalLexer lexer;
+    std::vector<token_t> viewed;
+    lexer.tokenize(content, [&](ModalLexer::token_view_t&& t) {
+        viewed.emplace_back(t.name, std::string(t.content));
+    });
+    ASSERT_EQ(viewed.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(viewed[i], expected[i]) << "token " << i;
+    }
+
+    for (size_t split = 0; split <= content.size(); ++split) {
+        std::vector<token_t> actual;
+        auto sink = [&](token_t&& t) { actual.push_back(std::move(t)); };
+
+        ModalLexer first;
+        first.process(std::string_view(content).substr(0, split), sink);
+
+        ModalLexer second;
+        second.restore(first.snapshot());
+        second.process(std::string_view(content).substr(split), sink);
+        second.flush(sink);
+
+        ASSERT_EQ(actual.size(), expected.size()) << "split at " << split;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(actual[i], expected[i]) << "split at " << split;
+        }
+    }
+}
+
+// flush returns to code mode
+TEST_F(modal_lextable_fixture, lexer_flush_resets_mode)
+{
+    ModalLexer lexer;
+    lex(lexer, "/* unterminated");
+    const auto tokens = lex(lexer, "class");
+    ASSERT_EQ(tokens.size(), 1u);
+    EXPECT_EQ(tokens[0], token_t(symbol_t::CLASS));
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
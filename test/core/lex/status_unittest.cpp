@@ -0,0 +1,128 @@
+#include <core/lex/status.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct ring_queue_fixture : ::testing::Test
+{
+protected:
+    using queue_t = RingQueue<std::string, 4>;
+
+    // counts live objects to check that every element is destroyed exactly once
+    struct counted
+    {
+        static inline int live = 0;
+        int value;
+        counted(int v) : value(v) { ++live; }
+        counted(const counted& other) : value(other.value) { ++live; }
+        counted(counted&& other) : value(other.value) { ++live; }
+        ~counted() { --live; }
+    };
+
+    queue_t queue;
+};
+
+TEST_F(ring_queue_fixture, default_empty)
+{
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), static_cast<size_t>(0));
+    EXPECT_EQ(queue.capacity(), queue_t::inline_capacity);
+}
+
+TEST_F(ring_queue_fixture, fifo_order)
+{
+    queue.push("a");
+    queue.emplace("b");
+    queue.emplace(3, 'c');
+    EXPECT_EQ(queue.size(), static_cast<size_t>(3));
+    EXPECT_EQ(queue.front(), "a");
+    queue.pop();
+    EXPECT_EQ(queue.front(), "b");
+    queue.pop();
+    EXPECT_EQ(queue.front(), "ccc");
+    queue.pop();
+    EXPECT_TRUE(queue.empty());
+}
+
+// steady push/pop wraps around inline storage without ever growing
+TEST_F(ring_queue_fixture, wrap_around_no_growth)
+{
+    for (int i = 0; i < 1000; ++i) {
+        queue.push(std::to_string(i));
+        queue.push(std::to_string(i + 1));
+        queue.push(std::to_string(i + 2));
+        EXPECT_EQ(queue.front(), std::to_string(i));
+        queue.pop();
+        queue.pop();
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.capacity(), queue_t::inline_capacity);
+}
+
+// growing from a wrapped-around state keeps order and capacity never shrinks
+TEST_F(ring_queue_fixture, grow_keeps_order)
+{
+    queue.push("x");
+    queue.push("y");
+    queue.pop();
+    queue.pop();
+    for (int i = 0; i < 10; ++i) {
+        queue.push(std::to_string(i));
+    }
+    EXPECT_EQ(queue.capacity(), static_cast<size_t>(16));
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(queue.front(), std::to_string(i));
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.capacity(), static_cast<size_t>(16));
+}
+
+TEST_F(ring_queue_fixture, copy_move)
+{
+    for (int i = 0; i < 3; ++i) {
+        queue.push(std::to_string(i));
+    }
+    queue_t copy(queue);
+    queue_t moved(std::move(queue));
+    EXPECT_TRUE(queue.empty());
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(copy.front(), std::to_string(i));
+        EXPECT_EQ(moved.front(), std::to_string(i));
+        copy.pop();
+        moved.pop();
+    }
+
+    // heap storage is taken as a whole
+    for (int i = 0; i < 6; ++i) {
+        moved.push(std::to_string(i));
+    }
+    queue = std::move(moved);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.capacity(), queue_t::inline_capacity);
+    EXPECT_EQ(queue.size(), static_cast<size_t>(6));
+    EXPECT_EQ(queue.front(), "0");
+}
+
+TEST_F(ring_queue_fixture, destroys_elements)
+{
+    {
+        RingQueue<counted, 2> q;
+        for (int i = 0; i < 5; ++i) {
+            q.emplace(i);
+        }
+        q.pop();
+        EXPECT_EQ(counted::live, 4);
+        RingQueue<counted, 2> copy(q);
+        EXPECT_EQ(counted::live, 8);
+    }
+    EXPECT_EQ(counted::live, 0);
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
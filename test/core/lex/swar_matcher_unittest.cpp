@@ -0,0 +1,147 @@
+#include <core/lex/swar_matcher.hpp>
+#include <core/lex/dynamic_lextable.hpp>
+#include <core/symbol.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct swar_matcher_fixture : ::testing::Test
+{
+protected:
+    using matcher_t = SwarMatcher<Symbol>;
+    using pairs_t = std::vector<std::pair<std::string, Symbol>>;
+
+    pairs_t pairs = {
+        {"/", Symbol::FORWARD_SLASH},
+        {"//", Symbol::BEGIN_NLINE_COMMENT},
+        {"///", Symbol::BEGIN_SLINE_COMMENT},
+        {"template", Symbol::TEMPLATE},
+        {"@param", Symbol::PARAM},
+        {"@end_section", Symbol::TAG},
+    };
+    matcher_t matcher = matcher_t(pairs.begin(), pairs.end());
+
+    // input padded so that matcher may read as far as it needs to
+    static std::string pad(std::string str)
+    {
+        str.resize(str.size() + 16, '\0');
+        return str;
+    }
+};
+
+TEST_F(swar_matcher_fixture, reach)
+{
+    EXPECT_EQ(matcher.reach('/'), matcher_t::width);
+    EXPECT_EQ(matcher.reach('t'), matcher_t::width);
+    EXPECT_EQ(matcher.reach('@'), std::string("@end_section").size());
+    EXPECT_EQ(matcher.reach('x'), 0u);
+}
+
+TEST_F(swar_matcher_fixture, match_longest)
+{
+    const std::string str = pad("/// x");
+    const auto match = matcher.match(str.data());
+    EXPECT_EQ(match.len, 3u);
+    EXPECT_EQ(match.symbol, Symbol::BEGIN_SLINE_COMMENT);
+}
+
+TEST_F(swar_matcher_fixture, match_shorter)
+{
+    const std::string str = pad("/x");
+    const auto match = matcher.match(str.data());
+    EXPECT_EQ(match.len, 1u);
+    EXPECT_EQ(match.symbol, Symbol::FORWARD_SLASH);
+}
+
+TEST_F(swar_matcher_fixture, match_full_word)
+{
+    const std::string str = pad("template<");
+    const auto match = matcher.match(str.data());
+    EXPECT_EQ(match.len, 8u);
+    EXPECT_EQ(match.symbol, Symbol::TEMPLATE);
+}
+
+TEST_F(swar_matcher_fixture, match_near_miss)
+{
+    const std::string str = pad("templat;");
+    const auto match = matcher.match(str.data());
+    EXPECT_EQ(match.len, 0u);
+    EXPECT_EQ(match.walked, 7u);
+}
+
+TEST_F(swar_matcher_fixture, match_long_lexeme)
+{
+    const std::string str = pad("@end_section x");
+    const auto match = matcher.match(str.data());
+    EXPECT_EQ(match.len, 12u);
+    EXPECT_EQ(match.symbol, Symbol::TAG);
+}
+
+TEST_F(swar_matcher_fixture, match_long_lexeme_near_miss)
+{
+    const std::string str = pad("@end_sectiox");
+    const auto match = matcher.match(str.data());
+    EXPECT_EQ(match.len, 0u);
+    EXPECT_EQ(match.walked, 11u);
+}
+
+TEST_F(swar_matcher_fixture, match_common_prefix_of_any)
+{
+    const std::string str = pad("@pa;");
+    const auto match = matcher.match(str.data());
+    EXPECT_EQ(match.len, 0u);
+    EXPECT_EQ(match.walked, 3u);
+}
+
+TEST_F(swar_matcher_fixture, last_symbol_wins)
+{
+    pairs.emplace_back("/", Symbol::STAR);
+    const matcher_t m(pairs.begin(), pairs.end());
+    const std::string str = pad("/x");
+    EXPECT_EQ(m.match(str.data()).symbol, Symbol::STAR);
+}
+
+// same result as walking a table built from the same lexemes
+TEST_F(swar_matcher_fixture, same_as_table)
+{
+    const auto all = make_lexeme_symbol_pairs({"end_section"});
+    const matcher_t m(all.begin(), all.end());
+    dynamic_lextable_t table(all.begin(), all.end());
+
+    const std::string inputs[] = {
+        "template", "templates", "tem", "class", "clas", "struct",
+        "@tparam", "@tpara", "@return", "@end_section", "@end_",
+        "/*!", "/*", "///", "*/", "**", " ", "\n", "@"
+    };
+    for (const std::string& input : inputs) {
+        const std::string str = pad(input);
+        table.reset();
+        size_t walked = 0;
+        size_t len = 0;
+        Symbol symbol = {};
+        while (table.transition(str[walked], [](){})) {
+            ++walked;
+            if (table.is_accept()) {
+                len = walked;
+                symbol = *table.get_symbol();
+            }
+        }
+        ASSERT_NE(m.reach(str[0]), 0u) << input;
+        const auto match = m.match(str.data());
+        EXPECT_EQ(match.len, len) << input;
+        if (len) {
+            EXPECT_EQ(match.symbol, symbol) << input;
+        } else {
+            EXPECT_EQ(match.walked, walked) << input;
+        }
+    }
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
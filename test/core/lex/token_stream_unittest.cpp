@@ -0,0 +1,105 @@
+#include <core/lex/lexer.hpp>
+#include <core/lex/token_stream.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace docgen {
+namespace core {
+namespace lex {
+
+struct token_stream_fixture : ::testing::Test
+{
+protected:
+    using stream_t = TokenStream<Symbol>;
+    using token_view_t = stream_t::token_view_t;
+
+    static constexpr const char* content =
+        "#include <gtest/gtest.h>\n"
+        "/// some description\n"
+        "/// @param x a parameter\n"
+        "/*! @tparam T\n"
+        " */\n"
+        "template <class T>\n"
+        "void f(int x) {}\n"
+        ;
+};
+
+TEST_F(token_stream_fixture, symbol_is_one_byte)
+{
+    static_assert(sizeof(Symbol) == 1);
+    static_assert(sizeof(stream_t::offset_t) == 4);
+}
+
+TEST_F(token_stream_fixture, push_index)
+{
+    const std::string source("abc/// def");
+    stream_t stream(source);
+    stream.push(Symbol::TEXT, std::string_view(source).substr(0, 3));
+    stream.push(Symbol::BEGIN_SLINE_COMMENT);
+    stream.push(token_view_t(Symbol::TEXT, std::string_view(source).substr(6)));
+
+    EXPECT_EQ(stream.size(), static_cast<size_t>(3));
+    EXPECT_EQ(stream[0].name, Symbol::TEXT);
+    EXPECT_EQ(stream[0].content, "abc");
+    EXPECT_EQ(stream[0].content.data(), source.data());
+    EXPECT_EQ(stream[1].name, Symbol::BEGIN_SLINE_COMMENT);
+    EXPECT_TRUE(stream[1].content.empty());
+    EXPECT_EQ(stream[2].content, " def");
+    EXPECT_EQ(stream.offsets()[2], static_cast<uint32_t>(6));
+    EXPECT_EQ(stream.lengths()[2], static_cast<uint32_t>(4));
+
+    stream.clear();
+    EXPECT_TRUE(stream.empty());
+    EXPECT_EQ(stream.begin(), stream.end());
+}
+
+// whole-file stream holds exactly the tokens passed to a sink
+TEST_F(token_stream_fixture, tokenize_stream)
+{
+    Lexer lexer;
+    const std::string source(content);
+
+    std::vector<token_view_t> expected;
+    lexer.tokenize(source, [&](token_view_t&& t) { expected.push_back(t); });
+
+    const auto stream = lexer.tokenize(source);
+    EXPECT_EQ(stream.source().data(), source.data());
+    ASSERT_EQ(stream.size(), expected.size());
+
+    size_t i = 0;
+    for (const auto& t : stream) {
+        EXPECT_EQ(t.name, expected[i].name);
+        EXPECT_EQ(t.content, expected[i].content);
+        if (t.name == Symbol::TEXT) {
+            EXPECT_EQ(t.content.data(), expected[i].content.data());
+        }
+        ++i;
+    }
+    EXPECT_EQ(i, expected.size());
+}
+
+TEST_F(token_stream_fixture, iterator_random_access)
+{
+    Lexer lexer;
+    const std::string source(content);
+    const auto stream = lexer.tokenize(source);
+
+    auto it = stream.begin();
+    EXPECT_EQ(stream.end() - it, static_cast<std::ptrdiff_t>(stream.size()));
+    EXPECT_EQ((*(it + 2)).name, stream[2].name);
+    EXPECT_EQ(it[3].name, stream[3].name);
+    EXPECT_EQ((stream.end() - 1).symbol(), stream.symbols().back());
+
+    // symbols can be scanned directly
+    const auto n_param = std::count(stream.symbols().begin(), stream.symbols().end(), Symbol::PARAM);
+    const auto n_param_it = std::count_if(stream.begin(), stream.end(),
+            [](const token_view_t& t) { return t.name == Symbol::PARAM; });
+    EXPECT_EQ(n_param, 1);
+    EXPECT_EQ(n_param_it, n_param);
+}
+
+} // namespace lex
+} // namespace core
+} // namespace docgen
@@ -0,0 +1,68 @@
+#include <core/lex/lexer.hpp>
+#include <core/parse/parser.hpp>
+#include <gtest/gtest.h>
+#include <string_view>
+
+namespace docgen {
+namespace core {
+namespace parse {
+
+struct parser_fixture : ::testing::Test
+{
+protected:
+    using lexer_t = lex::ModalLexer;
+
+    // lexes content (coalescing runs if coalesce) and parses every token as Session does
+    static nlohmann::json parse(std::string_view content, bool coalesce)
+    {
+        lexer_t lexer;
+        lexer.coalesce(coalesce);
+        Parser parser;
+        auto sink = [&](lexer_t::token_t&& token) {
+            parser.process(token);
+            if (parser.skip_block_requested()) {
+                lexer.skip_block();
+            }
+            lexer.want_text(parser.needs_text());
+        };
+        lexer.process(content, sink);
+        lexer.flush(sink);
+        return parser.parsed();
+    }
+};
+
+// a newline run writes nothing, as single newline tokens did
+TEST_F(parser_fixture, coalesce_multiline_tparamlist)
+{
+    static constexpr std::string_view content =
+        "/// doc\n"
+        "template <class A,\n"
+        "          class B>\n"
+        "struct S;\n";
+
+    const nlohmann::json expected = parse(content, false);
+    EXPECT_EQ(parse(content, true), expected);
+    ASSERT_TRUE(expected.contains("classes"));
+    EXPECT_EQ(expected["classes"][0]["tparamlists"][0], "class A,          class B");
+}
+
+// whitespace runs are written as one space per char, as single whitespace tokens were
+TEST_F(parser_fixture, coalesce_whitespace_in_doc)
+{
+    static constexpr std::string_view content =
+        "/// some   doc\t\t text\n"
+        "///\n"
+        "///    more\n"
+        "template <class  T>\n"
+        "struct S\n"
+        "{\n"
+        "};\n";
+
+    const nlohmann::json expected = parse(content, false);
+    EXPECT_FALSE(expected.is_null());
+    EXPECT_EQ(parse(content, true), expected);
+}
+
+} // namespace parse
+} // namespace core
+} // namespace docgen
@@ -38,5 +38,12 @@ TEST_F(exceptions_fixture, exception_bad_flags)
     EXPECT_EQ(std::string(error.what()), expected);
 }
 
+TEST_F(exceptions_fixture, exception_bad_glob)
+{
+    bad_glob error("src/[a-z", "unterminated [");
+    std::string expected = "Docgen encountered a problem: bad glob pattern \"src/[a-z\": unterminated [";
+    EXPECT_EQ(std::string(error.what()), expected);
+}
+
 } // namespace exceptions
 } // namespace docgen
@@ -0,0 +1,167 @@
+#include <io/dir_walker.hpp>
+#include <io/temp_dir_fixture.hpp>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace docgen {
+namespace io {
+
+struct dir_walker_fixture : temp_dir_fixture
+{
+protected:
+    // Every entry of dir by relative path (e.g. "a/b/x.hpp"), as walked.
+    static void flatten(const WalkedDir& dir, const std::string& prefix,
+                        std::map<std::string, const WalkedEntry*>& entries)
+    {
+        for (const WalkedEntry& entry : dir.entries) {
+            const std::string rel = prefix + entry.name;
+            entries[rel] = &entry;
+            if (entry.dir) {
+                flatten(*entry.dir, rel + '/', entries);
+            }
+        }
+    }
+
+    static std::map<std::string, const WalkedEntry*> flatten(const WalkedDir& dir)
+    {
+        std::map<std::string, const WalkedEntry*> entries;
+        flatten(dir, "", entries);
+        return entries;
+    }
+
+    // a/x.hpp, a/b/y.hpp, a/b/c/z.hpp, top.hpp and symlinks to a, top.hpp and nothing
+    void make_tree()
+    {
+        write_file("a/x.hpp", "x");
+        write_file("a/b/y.hpp", "yy");
+        write_file("a/b/c/z.hpp", "zzz");
+        write_file("top.hpp", "top");
+        ASSERT_EQ(symlink("a", path("dir_link").c_str()), 0);
+        ASSERT_EQ(symlink("top.hpp", path("file_link").c_str()), 0);
+        ASSERT_EQ(symlink("missing", path("broken_link").c_str()), 0);
+    }
+};
+
+TEST_F(dir_walker_fixture, walk)
+{
+    make_tree();
+    for (size_t jobs : {1, 4}) {
+        const WalkedDir root = walk_dir(dir, {}, jobs);
+        EXPECT_EQ(root.error, 0);
+        const auto entries = flatten(root);
+        ASSERT_EQ(entries.size(), static_cast<size_t>(10)) << jobs;
+
+        const WalkedEntry& z = *entries.at("a/b/c/z.hpp");
+        EXPECT_EQ(z.kind, EntryKind::FILE);
+        EXPECT_FALSE(z.symlink);
+        FileStat stat;
+        ASSERT_TRUE(stat_file(path("a/b/c/z.hpp").c_str(), stat));
+        EXPECT_EQ(z.stat, stat);
+        EXPECT_EQ(z.stat.size, static_cast<uintmax_t>(3));
+
+        EXPECT_EQ(entries.at("a")->kind, EntryKind::DIRECTORY);
+        EXPECT_EQ(entries.at("a/b/c")->kind, EntryKind::DIRECTORY);
+        EXPECT_NE(entries.at("a/b/c")->dir, nullptr);
+    }
+}
+
+// symlinks are resolved but never followed into
+TEST_F(dir_walker_fixture, symlinks)
+{
+    make_tree();
+    const WalkedDir root = walk_dir(dir, {}, 2);
+    const auto entries = flatten(root);
+
+    const WalkedEntry& dir_link = *entries.at("dir_link");
+    EXPECT_TRUE(dir_link.symlink);
+    EXPECT_EQ(dir_link.kind, EntryKind::DIRECTORY);
+    EXPECT_EQ(dir_link.target, path("a"));
+    EXPECT_EQ(dir_link.dir, nullptr);
+    EXPECT_EQ(entries.count("dir_link/x.hpp"), static_cast<size_t>(0));
+
+    const WalkedEntry& file_link = *entries.at("file_link");
+    EXPECT_TRUE(file_link.symlink);
+    EXPECT_EQ(file_link.kind, EntryKind::FILE);
+    EXPECT_EQ(file_link.target, path("top.hpp"));
+    EXPECT_EQ(file_link.stat.size, static_cast<uintmax_t>(3));
+
+    const WalkedEntry& broken_link = *entries.at("broken_link");
+    EXPECT_TRUE(broken_link.symlink);
+    EXPECT_EQ(broken_link.kind, EntryKind::OTHER);
+    EXPECT_TRUE(broken_link.target.empty());
+}
+
+// excluded directories are classified but not listed
+TEST_F(dir_walker_fixture, excludes)
+{
+    make_tree();
+    const WalkedDir root = walk_dir(dir, {path("a/b")}, 2);
+    const auto entries = flatten(root);
+    const WalkedEntry& b = *entries.at("a/b");
+    EXPECT_EQ(b.kind, EntryKind::DIRECTORY);
+    EXPECT_EQ(b.dir, nullptr);
+    EXPECT_EQ(entries.count("a/b/y.hpp"), static_cast<size_t>(0));
+    EXPECT_EQ(entries.count("a/x.hpp"), static_cast<size_t>(1));
+}
+
+TEST_F(dir_walker_fixture, missing_dir)
+{
+    const WalkedDir root = walk_dir(path("missing"), {}, 1);
+    EXPECT_EQ(root.error, ENOENT);
+    EXPECT_TRUE(root.entries.empty());
+}
+
+// entries of unknown type (as some filesystems report them) are classified by stat
+TEST_F(dir_walker_fixture, d_type_unknown)
+{
+    make_tree();
+    const int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    ASSERT_GE(fd, 0);
+
+    auto classify = [&](const std::string& name, WalkedEntry& entry) {
+        entry.name = name;
+        return classify_entry(fd, path(name), DT_UNKNOWN, entry);
+    };
+
+    WalkedEntry a, top, dir_link, file_link, broken_link, missing;
+    EXPECT_TRUE(classify("a", a));
+    EXPECT_EQ(a.kind, EntryKind::DIRECTORY);
+
+    EXPECT_FALSE(classify("top.hpp", top));
+    EXPECT_EQ(top.kind, EntryKind::FILE);
+    EXPECT_EQ(top.stat.size, static_cast<uintmax_t>(3));
+    EXPECT_FALSE(top.symlink);
+
+    EXPECT_FALSE(classify("dir_link", dir_link));
+    EXPECT_TRUE(dir_link.symlink);
+    EXPECT_EQ(dir_link.kind, EntryKind::DIRECTORY);
+    EXPECT_EQ(dir_link.target, path("a"));
+
+    EXPECT_FALSE(classify("file_link", file_link));
+    EXPECT_TRUE(file_link.symlink);
+    EXPECT_EQ(file_link.kind, EntryKind::FILE);
+
+    EXPECT_FALSE(classify("broken_link", broken_link));
+    EXPECT_TRUE(broken_link.symlink);
+    EXPECT_EQ(broken_link.kind, EntryKind::OTHER);
+
+    EXPECT_FALSE(classify("missing", missing));
+    EXPECT_EQ(missing.kind, EntryKind::OTHER);
+
+    close(fd);
+}
+
+TEST_F(dir_walker_fixture, walked_path)
+{
+    EXPECT_EQ(walked_path("/a/b", "c"), "/a/b/c");
+    EXPECT_EQ(walked_path("/a/b/", "c"), "/a/b/c");
+    EXPECT_EQ(walked_path("/", "c"), "/c");
+}
+
+} // namespace io
+} // namespace docgen
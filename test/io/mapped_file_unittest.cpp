@@ -0,0 +1,108 @@
+#include <io/mapped_file.hpp>
+#include <io/temp_dir_fixture.hpp>
+#include <exceptions/exceptions.hpp>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace docgen {
+namespace io {
+
+struct mapped_file_fixture : temp_dir_fixture
+{
+protected:
+    static std::string pattern(size_t size)
+    {
+        std::string content(size, '\0');
+        for (size_t i = 0; i < size; ++i) {
+            content[i] = static_cast<char>('a' + i * 7 % 26);
+        }
+        return content;
+    }
+};
+
+TEST_F(mapped_file_fixture, empty)
+{
+    MappedFile file(write_file("empty.hpp", "").c_str());
+    EXPECT_FALSE(file.mapped());
+    EXPECT_TRUE(file.view().empty());
+}
+
+// small files are read rather than mapped
+TEST_F(mapped_file_fixture, small)
+{
+    for (size_t size : {size_t(1), size_t(100), MappedFile::MAP_MIN_SIZE - 1}) {
+        const std::string content = pattern(size);
+        MappedFile file(write_file("small.hpp", content).c_str());
+        EXPECT_FALSE(file.mapped()) << size;
+        EXPECT_EQ(file.view(), content) << size;
+    }
+}
+
+TEST_F(mapped_file_fixture, large)
+{
+    for (size_t size : {MappedFile::MAP_MIN_SIZE, size_t(1) << 20}) {
+        const std::string content = pattern(size);
+        MappedFile file(write_file("large.hpp", content).c_str());
+        EXPECT_TRUE(file.mapped()) << size;
+        EXPECT_EQ(file.view(), content) << size;
+    }
+}
+
+// a pipe is read until its end, however much it holds
+TEST_F(mapped_file_fixture, fifo)
+{
+    const std::string fifo_path = path("fifo");
+    ASSERT_EQ(mkfifo(fifo_path.c_str(), 0600), 0);
+    const std::string content = pattern(300000);
+    std::thread writer([&]() {
+        int fd = open(fifo_path.c_str(), O_WRONLY);
+        ASSERT_GE(fd, 0);
+        for (size_t n = 0; n < content.size();) {
+            // in pieces, for the reader to see short reads
+            ssize_t w = write(fd, content.data() + n, std::min<size_t>(content.size() - n, 4093));
+            ASSERT_GT(w, 0);
+            n += w;
+        }
+        close(fd);
+    });
+    MappedFile file(fifo_path.c_str());
+    writer.join();
+    EXPECT_FALSE(file.mapped());
+    EXPECT_EQ(file.view(), content);
+}
+
+TEST_F(mapped_file_fixture, errors)
+{
+    EXPECT_THROW(MappedFile(path("missing.hpp").c_str()), exceptions::file_open_error);
+    // a directory opens, but cannot be read
+    EXPECT_THROW(MappedFile(dir.c_str()), exceptions::system_error);
+}
+
+// views stay valid (and equal) in whatever a file is moved to
+TEST_F(mapped_file_fixture, move)
+{
+    for (size_t size : {size_t(5), size_t(1000), MappedFile::MAP_MIN_SIZE}) {
+        const std::string content = pattern(size);
+        const std::string file_path = write_file("f.hpp", content);
+        MappedFile file(file_path.c_str());
+        const bool mapped = file.mapped();
+
+        MappedFile moved(std::move(file));
+        EXPECT_EQ(moved.mapped(), mapped);
+        EXPECT_EQ(moved.view(), content);
+        EXPECT_TRUE(file.view().empty());
+
+        MappedFile assigned(write_file("g.hpp", "other").c_str());
+        assigned = std::move(moved);
+        EXPECT_EQ(assigned.mapped(), mapped);
+        EXPECT_EQ(assigned.view(), content);
+    }
+}
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,175 @@
+#include <io/path_filter.hpp>
+#include <exceptions/exceptions.hpp>
+#include <gtest/gtest.h>
+
+namespace docgen {
+namespace io {
+
+struct path_filter_fixture : ::testing::Test
+{
+protected:
+    // State of path (relative, '/'-separated) as walked from the root.
+    static PathFilter::state_t walk(const PathFilter& filter, const std::string& path)
+    {
+        PathFilter::state_t state = filter.root();
+        size_t first = 0;
+        while (first < path.size()) {
+            size_t last = std::min(path.find('/', first), path.size());
+            state = filter.step(state, std::string_view(path).substr(first, last - first));
+            first = last + 1;
+        }
+        return state;
+    }
+
+    static bool includes(const PathFilter& filter, const std::string& path)
+    {
+        return filter.includes(walk(filter, path));
+    }
+
+    static bool prunes(const PathFilter& filter, const std::string& path)
+    {
+        return filter.prunes(walk(filter, path));
+    }
+};
+
+TEST_F(path_filter_fixture, glob_match_literal)
+{
+    EXPECT_TRUE(glob_match("lexer.hpp", "lexer.hpp"));
+    EXPECT_FALSE(glob_match("lexer.hpp", "lexer.cpp"));
+    EXPECT_FALSE(glob_match("lexer.hpp", "lexer.hpp2"));
+    EXPECT_TRUE(glob_match("", ""));
+}
+
+TEST_F(path_filter_fixture, glob_match_star)
+{
+    EXPECT_TRUE(glob_match("*.hpp", "lexer.hpp"));
+    EXPECT_TRUE(glob_match("*.hpp", ".hpp"));
+    EXPECT_FALSE(glob_match("*.hpp", "lexer.hpp.in"));
+    EXPECT_TRUE(glob_match("*lex*", "modal_lexer.hpp"));
+    EXPECT_TRUE(glob_match("a*b*c", "aXbYbZc"));
+    EXPECT_FALSE(glob_match("a*b*c", "aXbYbZ"));
+    EXPECT_TRUE(glob_match("**", "anything"));
+}
+
+TEST_F(path_filter_fixture, glob_match_question_class_escape)
+{
+    EXPECT_TRUE(glob_match("data_?.txt", "data_1.txt"));
+    EXPECT_FALSE(glob_match("data_?.txt", "data_10.txt"));
+    EXPECT_TRUE(glob_match("data_[0-3].txt", "data_3.txt"));
+    EXPECT_FALSE(glob_match("data_[0-3].txt", "data_4.txt"));
+    EXPECT_TRUE(glob_match("data_[!0-3].txt", "data_4.txt"));
+    EXPECT_FALSE(glob_match("data_[^0-3].txt", "data_0.txt"));
+    EXPECT_TRUE(glob_match("[]]", "]"));
+    EXPECT_TRUE(glob_match("\\*.hpp", "*.hpp"));
+    EXPECT_FALSE(glob_match("\\*.hpp", "a.hpp"));
+}
+
+TEST_F(path_filter_fixture, empty_includes_everything)
+{
+    PathFilter filter({});
+    EXPECT_TRUE(filter.empty());
+    EXPECT_TRUE(includes(filter, "src/docgen.cpp"));
+    EXPECT_FALSE(prunes(filter, "src"));
+}
+
+TEST_F(path_filter_fixture, unanchored_at_any_depth)
+{
+    PathFilter filter({"*.hpp"});
+    EXPECT_TRUE(includes(filter, "lexer.hpp"));
+    EXPECT_TRUE(includes(filter, "src/core/lex/lexer.hpp"));
+    EXPECT_FALSE(includes(filter, "src/core/lex/lexer.cpp"));
+    EXPECT_FALSE(prunes(filter, "src/core"));
+}
+
+TEST_F(path_filter_fixture, anchored_at_root)
+{
+    PathFilter filter({"src/*.cpp"});
+    EXPECT_TRUE(includes(filter, "src/docgen.cpp"));
+    EXPECT_FALSE(includes(filter, "test/src/docgen.cpp"));
+    EXPECT_FALSE(includes(filter, "src/io/dir_walker.cpp"));
+    EXPECT_FALSE(prunes(filter, "src"));
+    EXPECT_TRUE(prunes(filter, "test"));
+    EXPECT_TRUE(prunes(filter, "src/io"));
+
+    PathFilter leading_slash({"/src/*.cpp"});
+    EXPECT_TRUE(includes(leading_slash, "src/docgen.cpp"));
+    EXPECT_TRUE(prunes(leading_slash, "test"));
+}
+
+TEST_F(path_filter_fixture, double_star)
+{
+    PathFilter filter({"**/*.hpp"});
+    EXPECT_TRUE(includes(filter, "lexer.hpp"));
+    EXPECT_TRUE(includes(filter, "src/core/lex/lexer.hpp"));
+    EXPECT_FALSE(includes(filter, "src/core/lex/lexer.cpp"));
+
+    PathFilter middle({"src/**/lex/*.hpp"});
+    EXPECT_TRUE(includes(middle, "src/lex/lexer.hpp"));
+    EXPECT_TRUE(includes(middle, "src/core/lex/lexer.hpp"));
+    EXPECT_TRUE(includes(middle, "src/a/b/c/lex/lexer.hpp"));
+    EXPECT_FALSE(includes(middle, "src/core/parse/parser.hpp"));
+    EXPECT_FALSE(prunes(middle, "src/core/parse"));
+    EXPECT_TRUE(prunes(middle, "test"));
+}
+
+TEST_F(path_filter_fixture, directory_match_covers_contents)
+{
+    PathFilter filter({"src/core"});
+    EXPECT_TRUE(includes(filter, "src/core/lex/lexer.hpp"));
+    EXPECT_FALSE(includes(filter, "src/docgen.cpp"));
+    EXPECT_FALSE(prunes(filter, "src/core/lex"));
+    EXPECT_TRUE(prunes(filter, "src/io"));
+}
+
+TEST_F(path_filter_fixture, exclude)
+{
+    PathFilter filter({"!**/third_party/**"});
+    EXPECT_TRUE(includes(filter, "src/docgen.cpp"));
+    EXPECT_FALSE(includes(filter, "third_party/json.hpp"));
+    EXPECT_FALSE(includes(filter, "libs/third_party/json.hpp"));
+    EXPECT_TRUE(prunes(filter, "libs/third_party"));
+    EXPECT_FALSE(prunes(filter, "libs"));
+
+    PathFilter unanchored({"!.git"});
+    EXPECT_TRUE(prunes(unanchored, ".git"));
+    EXPECT_TRUE(prunes(unanchored, "libs/benchmark/.git"));
+    EXPECT_FALSE(includes(unanchored, ".git/HEAD"));
+    EXPECT_TRUE(includes(unanchored, ".gitignore"));
+}
+
+TEST_F(path_filter_fixture, include_and_exclude)
+{
+    PathFilter filter({"*.hpp", "*.cpp", "!third_party", "!*_unittest.cpp"});
+    EXPECT_TRUE(includes(filter, "src/docgen.cpp"));
+    EXPECT_TRUE(includes(filter, "src/session.hpp"));
+    EXPECT_FALSE(includes(filter, "docs/index.html"));
+    EXPECT_FALSE(includes(filter, "test/io/path_filter_unittest.cpp"));
+    EXPECT_FALSE(includes(filter, "third_party/json.hpp"));
+    EXPECT_TRUE(prunes(filter, "third_party"));
+    EXPECT_FALSE(prunes(filter, "docs"));
+}
+
+TEST_F(path_filter_fixture, trailing_slash_and_empty_names)
+{
+    PathFilter filter({"src//core/"});
+    EXPECT_TRUE(includes(filter, "src/core/lexer.hpp"));
+    EXPECT_FALSE(includes(filter, "src/lexer.hpp"));
+}
+
+TEST_F(path_filter_fixture, bad_patterns)
+{
+    EXPECT_THROW(PathFilter({"src/[a-z"}), exceptions::bad_glob);
+    EXPECT_THROW(PathFilter({"src\\"}), exceptions::bad_glob);
+    EXPECT_THROW(PathFilter({""}), exceptions::bad_glob);
+    EXPECT_THROW(PathFilter({"!/"}), exceptions::bad_glob);
+
+    std::string deep = "a";
+    for (size_t i = 1; i < 64; ++i) {
+        deep += "/a";
+    }
+    EXPECT_THROW(PathFilter({deep}), exceptions::bad_glob);
+    EXPECT_NO_THROW(PathFilter({deep.substr(2)}));
+}
+
+} // namespace io
+} // namespace docgen
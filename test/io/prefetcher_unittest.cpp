@@ -0,0 +1,123 @@
+#include <io/prefetcher.hpp>
+#include <io/temp_dir_fixture.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace docgen {
+namespace io {
+
+struct prefetcher_fixture : temp_dir_fixture
+{
+protected:
+    static constexpr std::chrono::milliseconds SETTLE{50};  // time the thread is given to (wrongly) go further
+    static constexpr std::chrono::seconds TIMEOUT{10};
+
+    std::vector<std::string> paths;
+
+    // Writes n files and returns pointers to their paths (valid as long as the fixture).
+    std::vector<const char *> make_files(size_t n)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            paths.push_back(write_file("file" + std::to_string(i) + ".hpp", "int x;\n"));
+        }
+        return pointers();
+    }
+
+    std::vector<const char *> pointers() const
+    {
+        std::vector<const char *> ptrs;
+        for (const std::string& p : paths) {
+            ptrs.push_back(p.c_str());
+        }
+        return ptrs;
+    }
+
+    // Waits until prefetcher is done with n files, then a little longer
+    // so that going past n would show.
+    static void wait_done(const Prefetcher& prefetcher, size_t n)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while (prefetcher.done() < n && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::this_thread::sleep_for(SETTLE);
+    }
+};
+
+TEST_F(prefetcher_fixture, stays_depth_ahead)
+{
+    Prefetcher prefetcher(make_files(10), 3);
+    wait_done(prefetcher, 3);
+    EXPECT_EQ(prefetcher.done(), 3u);
+
+    prefetcher.start();
+    prefetcher.start();
+    wait_done(prefetcher, 5);
+    EXPECT_EQ(prefetcher.done(), 5u);
+
+    // never past the last file
+    for (size_t i = 0; i < 10; ++i) {
+        prefetcher.start();
+    }
+    wait_done(prefetcher, 10);
+    EXPECT_EQ(prefetcher.done(), 10u);
+    EXPECT_EQ(prefetcher.opened(), 10u);
+}
+
+// files that cannot be opened are gone past, counting toward depth like any other
+TEST_F(prefetcher_fixture, skips_unopenable)
+{
+    make_files(2);
+    paths.insert(paths.begin() + 1, path("missing.hpp"));
+    paths.push_back(path("missing/file.hpp"));
+
+    Prefetcher prefetcher(pointers(), 2);
+    wait_done(prefetcher, 2);
+    EXPECT_EQ(prefetcher.done(), 2u);
+    EXPECT_EQ(prefetcher.opened(), 1u);
+
+    prefetcher.start();
+    prefetcher.start();
+    wait_done(prefetcher, 4);
+    EXPECT_EQ(prefetcher.done(), 4u);
+    EXPECT_EQ(prefetcher.opened(), 2u);
+}
+
+TEST_F(prefetcher_fixture, destroy_while_waiting)
+{
+    std::optional<Prefetcher> prefetcher;
+    prefetcher.emplace(make_files(5), 1);
+    wait_done(*prefetcher, 1);
+    ASSERT_EQ(prefetcher->done(), 1u);
+
+    const auto begin = std::chrono::steady_clock::now();
+    prefetcher.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(1));
+}
+
+TEST_F(prefetcher_fixture, depth_0)
+{
+    std::optional<Prefetcher> prefetcher;
+    prefetcher.emplace(make_files(5), 0);
+    prefetcher->start();
+    std::this_thread::sleep_for(SETTLE);
+    EXPECT_EQ(prefetcher->done(), 0u);
+
+    const auto begin = std::chrono::steady_clock::now();
+    prefetcher.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(1));
+}
+
+TEST_F(prefetcher_fixture, no_paths)
+{
+    Prefetcher prefetcher({}, 4);
+    prefetcher.start();
+    EXPECT_EQ(prefetcher.done(), 0u);
+}
+
+} // namespace io
+} // namespace docgen
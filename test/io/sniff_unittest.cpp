@@ -0,0 +1,55 @@
+#include <io/sniff.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace docgen {
+namespace io {
+
+struct sniff_fixture : ::testing::Test
+{
+protected:
+};
+
+TEST_F(sniff_fixture, text)
+{
+    EXPECT_FALSE(looks_binary(""));
+    EXPECT_FALSE(looks_binary("/// Some doc.\nint f();\n"));
+    EXPECT_FALSE(looks_binary("/// caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\n"));
+}
+
+TEST_F(sniff_fixture, nul)
+{
+    EXPECT_TRUE(looks_binary(std::string_view("int f();\0", 9)));
+}
+
+TEST_F(sniff_fixture, nul_past_sniff_size)
+{
+    std::string content(SNIFF_SIZE, 'a');
+    content.push_back('\0');
+    EXPECT_FALSE(looks_binary(content));
+}
+
+TEST_F(sniff_fixture, invalid_utf8_ratio)
+{
+    // Latin-1 accents here and there are still text
+    std::string latin1 = "/// Returns the caf\xe9 menu of the day, or an empty one if closed.\n"
+                         "/// Na\xefve implementation: reads the whole file every time.\n";
+    EXPECT_FALSE(looks_binary(latin1));
+
+    // mostly bytes that cannot lead a sequence
+    std::string noise;
+    for (int i = 0; i < 100; ++i) {
+        noise += "ab\xff\xfe";
+    }
+    EXPECT_TRUE(looks_binary(noise));
+}
+
+TEST_F(sniff_fixture, sequence_cut_off_at_sniff_size)
+{
+    std::string content(SNIFF_SIZE - 1, 'a');
+    content += "\xe2\x82\xac";
+    EXPECT_FALSE(looks_binary(content));
+}
+
+} // namespace io
+} // namespace docgen
@@ -0,0 +1,50 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+namespace docgen {
+namespace io {
+
+// Fixture with a fresh directory to create files in,
+// removed along with everything in it after every test.
+struct temp_dir_fixture : ::testing::Test
+{
+protected:
+    std::string dir;    // canonical
+
+    void SetUp() override
+    {
+        std::string tmpl = (std::filesystem::temp_directory_path() / "docgen_unittest.XXXXXX").string();
+        ASSERT_NE(mkdtemp(tmpl.data()), nullptr);
+        dir = std::filesystem::canonical(tmpl).string();
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    // Path of name (relative, '/'-separated) within dir.
+    std::string path(const std::string& name) const
+    {
+        return dir + '/' + name;
+    }
+
+    // Writes content to file name (creating its parent directories) and returns its path.
+    std::string write_file(const std::string& name, std::string_view content) const
+    {
+        const std::string file_path = path(name);
+        std::filesystem::create_directories(std::filesystem::path(file_path).parent_path());
+        std::ofstream out(file_path, std::ios::binary);
+        out.write(content.data(), content.size());
+        return file_path;
+    }
+};
+
+} // namespace io
+} // namespace docgen
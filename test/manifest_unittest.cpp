@@ -0,0 +1,198 @@
+#include <manifest.hpp>
+#include <session.hpp>
+#include <exceptions/exceptions.hpp>
+#include <io/temp_dir_fixture.hpp>
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace docgen {
+
+struct manifest_fixture : io::temp_dir_fixture
+{
+protected:
+    static constexpr std::string_view content_a = "/// Function a.\nvoid a();\n";
+    static constexpr std::string_view content_b = "/// Function b, longer.\nvoid b();\n";
+
+    core::lex::modal_lextable_t lextable = core::lex::make_modal_lextable();
+    const nlohmann::json key = {{"tags", {"note"}}};
+    std::string manifest_path;
+    std::string file_path;
+
+    void SetUp() override
+    {
+        temp_dir_fixture::SetUp();
+        manifest_path = path("parsed.json.manifest");
+        file_path = write_file("a.hpp", content_a);
+    }
+
+    io::FileStat stat_of(const std::string& p) const
+    {
+        io::FileStat stat;
+        EXPECT_TRUE(io::stat_file(p.c_str(), stat));
+        return stat;
+    }
+
+    // Parses file_path with stat through manifest, returning the number of files parsed.
+    size_t parse(Manifest& manifest, const io::FileStat& stat, nlohmann::json& parsed) const
+    {
+        return manifest.parse({file_path}, {stat}, parsed, lextable, ParseOptions());
+    }
+
+    // Parses file_path with a manifest read from manifest_path (with key k) and saves it.
+    size_t parse_saved(const nlohmann::json& k, const io::FileStat& stat, nlohmann::json& parsed) const
+    {
+        Manifest manifest(manifest_path, k);
+        size_t n = parse(manifest, stat, parsed);
+        manifest.save();
+        return n;
+    }
+
+    nlohmann::json parsed_of(std::string_view content) const
+    {
+        nlohmann::json parsed;
+        Session().parse_buffer(content, parsed, file_path.c_str());
+        return parsed;
+    }
+
+    static std::string read(const std::string& p)
+    {
+        std::ifstream in(p, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+};
+
+// a change in size, mtime or inode has the file parsed again, an unchanged stat does not
+TEST_F(manifest_fixture, stat_change_invalidates)
+{
+    const io::FileStat stat = stat_of(file_path);
+    nlohmann::json parsed;
+    EXPECT_EQ(parse_saved(key, stat, parsed), static_cast<size_t>(1));
+    EXPECT_EQ(parsed, parsed_of(content_a));
+
+    // the stat is trusted: content is not even looked at
+    write_file("a.hpp", content_b);
+    {
+        Manifest manifest(manifest_path, key);
+        nlohmann::json reused;
+        EXPECT_EQ(parse(manifest, stat, reused), static_cast<size_t>(0));
+        EXPECT_EQ(reused, parsed_of(content_a));
+    }
+
+    io::FileStat size_changed = stat;
+    ++size_changed.size;
+    io::FileStat mtime_changed = stat;
+    ++mtime_changed.mtime;
+    io::FileStat inode_changed = stat;
+    ++inode_changed.inode;
+    for (const io::FileStat& changed : {size_changed, mtime_changed, inode_changed}) {
+        Manifest manifest(manifest_path, key);
+        nlohmann::json reparsed;
+        EXPECT_EQ(parse(manifest, changed, reparsed), static_cast<size_t>(1));
+        EXPECT_EQ(reparsed, parsed_of(content_b));
+    }
+}
+
+// a file whose stat changed but whose content did not is reused, and recorded with its new stat
+TEST_F(manifest_fixture, same_hash_reused)
+{
+    io::FileStat stat = stat_of(file_path);
+    nlohmann::json parsed;
+    EXPECT_EQ(parse_saved(key, stat, parsed), static_cast<size_t>(1));
+
+    ++stat.mtime;
+    nlohmann::json reused;
+    EXPECT_EQ(parse_saved(key, stat, reused), static_cast<size_t>(0));
+    EXPECT_EQ(reused, parsed);
+
+    write_file("a.hpp", content_b);
+    nlohmann::json trusted;
+    EXPECT_EQ(parse_saved(key, stat, trusted), static_cast<size_t>(0));
+    EXPECT_EQ(trusted, parsed);
+}
+
+// files no longer there are dropped
+TEST_F(manifest_fixture, records_exactly_paths)
+{
+    const std::string other_path = write_file("b.hpp", content_b);
+    Manifest manifest(manifest_path, key);
+    nlohmann::json parsed;
+    EXPECT_EQ(manifest.parse({file_path, other_path}, {stat_of(file_path), stat_of(other_path)},
+                             parsed, lextable, ParseOptions()), static_cast<size_t>(2));
+    EXPECT_EQ(parse(manifest, stat_of(file_path), parsed), static_cast<size_t>(0));
+    EXPECT_EQ(manifest.parse({other_path}, {stat_of(other_path)}, parsed, lextable, ParseOptions()),
+              static_cast<size_t>(1));
+}
+
+// a manifest recorded with another key, version or format is discarded as a whole
+TEST_F(manifest_fixture, mismatch_discards)
+{
+    const io::FileStat stat = stat_of(file_path);
+    nlohmann::json parsed;
+    EXPECT_EQ(parse_saved(key, stat, parsed), static_cast<size_t>(1));
+    EXPECT_EQ(parse_saved(key, stat, parsed), static_cast<size_t>(0));
+
+    {
+        Manifest manifest(manifest_path, {{"tags", {"other"}}});
+        EXPECT_EQ(parse(manifest, stat, parsed), static_cast<size_t>(1));
+    }
+
+    const nlohmann::json saved = nlohmann::json::parse(read(manifest_path));
+    for (const char *field : {"version", "format"}) {
+        nlohmann::json changed = saved;
+        changed[field] = "0";
+        write_file("parsed.json.manifest", changed.dump());
+        Manifest manifest(manifest_path, key);
+        EXPECT_EQ(parse(manifest, stat, parsed), static_cast<size_t>(1)) << field;
+    }
+}
+
+// a manifest that cannot be read as one is ignored as if there were none
+TEST_F(manifest_fixture, corrupt_ignored)
+{
+    const io::FileStat stat = stat_of(file_path);
+    nlohmann::json parsed;
+    EXPECT_EQ(parse_saved(key, stat, parsed), static_cast<size_t>(1));
+    const std::string saved = read(manifest_path);
+
+    nlohmann::json bad_entry = nlohmann::json::parse(saved);
+    bad_entry["files"][file_path]["hash"] = "not a hash";
+
+    for (const std::string& corrupt : {saved.substr(0, saved.size() / 2), std::string("\x00\xff garbage", 10),
+                                       std::string(), std::string("[]"), bad_entry.dump()}) {
+        write_file("parsed.json.manifest", corrupt);
+        Manifest manifest(manifest_path, key);
+        nlohmann::json reparsed;
+        EXPECT_EQ(parse(manifest, stat, reparsed), static_cast<size_t>(1));
+        EXPECT_EQ(reparsed, parsed_of(content_a));
+    }
+}
+
+// save writes a temporary file then renames it into place, so a failed save leaves the last manifest
+TEST_F(manifest_fixture, save_replaces_at_once)
+{
+    const io::FileStat stat = stat_of(file_path);
+    nlohmann::json parsed;
+    EXPECT_EQ(parse_saved(key, stat, parsed), static_cast<size_t>(1));
+    EXPECT_FALSE(std::filesystem::exists(manifest_path + ".tmp"));
+    const std::string saved = read(manifest_path);
+
+    // temporary file cannot be written
+    std::filesystem::create_directory(manifest_path + ".tmp");
+    Manifest manifest(manifest_path, {{"tags", {"other"}}});
+    EXPECT_EQ(parse(manifest, stat, parsed), static_cast<size_t>(1));
+    EXPECT_THROW(manifest.save(), exceptions::file_open_error);
+    EXPECT_EQ(read(manifest_path), saved);
+
+    std::filesystem::remove(manifest_path + ".tmp");
+    manifest.save();
+    EXPECT_FALSE(std::filesystem::exists(manifest_path + ".tmp"));
+    EXPECT_NE(read(manifest_path), saved);
+}
+
+} // namespace docgen
@@ -0,0 +1,110 @@
+#include <parse_file.hpp>
+#include <session.hpp>
+#include <exceptions/exceptions.hpp>
+#include <io/file_hash.hpp>
+#include <io/temp_dir_fixture.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace docgen {
+
+struct parse_file_fixture : io::temp_dir_fixture
+{
+protected:
+    core::lex::modal_lextable_t lextable = core::lex::make_modal_lextable();
+
+    // Content of file i, of which only some have doc comments and sizes differ.
+    static std::string content(size_t i)
+    {
+        if (i % 3 == 2) {
+            return "int undocumented_" + std::to_string(i) + "();\n";
+        }
+        std::string s = "/// Function " + std::to_string(i) + ".\n";
+        s.append(i * 37 % 11 * 64, ' ');
+        s += "\nvoid f" + std::to_string(i) + "(int x) { if (x) {} }\n";
+        return s;
+    }
+
+    std::vector<std::string> write_files(size_t n) const
+    {
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < n; ++i) {
+            paths.push_back(write_file("f" + std::to_string(i) + ".hpp", content(i)));
+        }
+        return paths;
+    }
+
+    static std::vector<uintmax_t> sizes_of(const std::vector<std::string>& paths)
+    {
+        std::vector<uintmax_t> sizes;
+        for (const std::string& p : paths) {
+            sizes.push_back(std::filesystem::file_size(p));
+        }
+        return sizes;
+    }
+};
+
+// results are in the order of paths whatever the number of jobs and the order files are started in
+TEST_F(parse_file_fixture, parse_each_order)
+{
+    const std::vector<std::string> paths = write_files(24);
+    const std::vector<uintmax_t> sizes = sizes_of(paths);
+
+    std::vector<nlohmann::json> expected;
+    for (const std::string& p : paths) {
+        nlohmann::json parsed;
+        parse_file(p.c_str(), parsed, lextable);
+        expected.push_back(parsed.empty() ? nlohmann::json() : parsed.back());
+    }
+
+    for (size_t jobs : {1, 2, 4, 8}) {
+        std::vector<uint64_t> hashes;
+        EXPECT_EQ(parse_each(paths, sizes, lextable, jobs, &hashes), expected) << jobs;
+        ASSERT_EQ(hashes.size(), paths.size());
+        for (size_t i = 0; i < paths.size(); ++i) {
+            EXPECT_EQ(hashes[i], io::hash_bytes(content(i))) << i;
+        }
+    }
+}
+
+// of several files that fail, what the first of them in paths threw is rethrown
+TEST_F(parse_file_fixture, parse_each_first_error_in_path_order)
+{
+    std::vector<std::string> paths = write_files(12);
+    paths[3] = path("missing_3.hpp");
+    paths[9] = path("missing_9.hpp");
+    std::vector<uintmax_t> sizes(paths.size(), 1);
+    sizes[9] = 1 << 20;  // started first
+
+    for (size_t jobs : {1, 4}) {
+        try {
+            parse_each(paths, sizes, lextable, jobs);
+            FAIL() << "expected file_open_error";
+        }
+        catch (const exceptions::file_open_error& e) {
+            EXPECT_NE(std::string(e.what()).find("missing_3.hpp"), std::string::npos) << e.what();
+        }
+    }
+}
+
+// parse_files appends results in order, and nothing if any file fails
+TEST_F(parse_file_fixture, parse_files)
+{
+    std::vector<std::string> paths = write_files(9);
+    nlohmann::json parsed;
+    parse_files(paths, parsed, lextable, 4);
+    ASSERT_EQ(parsed.size(), static_cast<size_t>(6));
+    for (size_t i = 0, k = 0; i < paths.size(); ++i) {
+        if (i % 3 != 2) {
+            EXPECT_EQ(parsed[k++][FILENAME_KEY], paths[i]);
+        }
+    }
+
+    paths.push_back(path("missing.hpp"));
+    nlohmann::json untouched;
+    EXPECT_THROW(parse_files(paths, untouched, lextable, 4), exceptions::file_open_error);
+    EXPECT_TRUE(untouched.is_null());
+}
+
+} // namespace docgen
@@ -0,0 +1,221 @@
+#include <result_cache.hpp>
+#include <session.hpp>
+#include <io/temp_dir_fixture.hpp>
+#include <gtest/gtest.h>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace docgen {
+
+namespace fs = std::filesystem;
+
+struct result_cache_fixture : io::temp_dir_fixture
+{
+protected:
+    const nlohmann::json key = {{"tags", {"note"}}};
+    std::string cache_dir;
+
+    void SetUp() override
+    {
+        temp_dir_fixture::SetUp();
+        cache_dir = path("cache");
+    }
+
+    static nlohmann::json result(size_t i)
+    {
+        return {{"functions", {{{"desc", "function " + std::to_string(100 + i)}}}}, {FILENAME_KEY, "/src/f.hpp"}};
+    }
+
+    // Path of the entry file of hash, if there is one (empty otherwise).
+    std::string entry_path(uint64_t hash) const
+    {
+        char prefix[32];
+        snprintf(prefix, sizeof(prefix), "%016" PRIx64 "-", hash);
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(cache_dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->path().filename().string().rfind(prefix, 0) == 0) {
+                return it->path().string();
+            }
+        }
+        return {};
+    }
+
+    uintmax_t cache_size() const
+    {
+        uintmax_t size = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(cache_dir)) {
+            if (entry.is_regular_file()) {
+                size += entry.file_size();
+            }
+        }
+        return size;
+    }
+};
+
+// results are stored without their name and loaded with the name asked for
+TEST_F(result_cache_fixture, store_load)
+{
+    ResultCache cache(cache_dir, key, 1 << 20);
+    EXPECT_FALSE(cache.load(1, "/src/f.hpp"));
+
+    cache.store(1, result(1));
+    cache.store(2, nlohmann::json());
+    std::optional<nlohmann::json> loaded = cache.load(1, "/other/g.hpp");
+    ASSERT_TRUE(loaded);
+    nlohmann::json expected = result(1);
+    expected[FILENAME_KEY] = "/other/g.hpp";
+    EXPECT_EQ(*loaded, expected);
+
+    loaded = cache.load(2, "/src/f.hpp");
+    ASSERT_TRUE(loaded);
+    EXPECT_TRUE(loaded->is_null());
+
+    // stored again (e.g. by a concurrent run)
+    cache.store(1, result(1));
+    EXPECT_EQ(*cache.load(1, "/other/g.hpp"), expected);
+    EXPECT_FALSE(cache.load(3, "/src/f.hpp"));
+}
+
+// results stored with another key are not seen
+TEST_F(result_cache_fixture, key_mismatch)
+{
+    ResultCache cache(cache_dir, key, 1 << 20);
+    ResultCache other(cache_dir, {{"tags", {"other"}}}, 1 << 20);
+    cache.store(1, result(1));
+    EXPECT_TRUE(cache.load(1, "a"));
+    EXPECT_FALSE(other.load(1, "a"));
+
+    other.store(1, result(2));
+    EXPECT_EQ((*cache.load(1, "a"))["functions"], result(1)["functions"]);
+    EXPECT_EQ((*other.load(1, "a"))["functions"], result(2)["functions"]);
+}
+
+// an entry that cannot be read as one is a miss
+TEST_F(result_cache_fixture, corrupt_entry)
+{
+    ResultCache cache(cache_dir, key, 1 << 20);
+    cache.store(1, result(1));
+    const std::string entry = entry_path(1);
+    ASSERT_FALSE(entry.empty());
+    fs::resize_file(entry, fs::file_size(entry) / 2);
+    EXPECT_FALSE(cache.load(1, "a"));
+}
+
+// entries used least recently are removed until the cache holds no more than EVICT_TO of max_size
+TEST_F(result_cache_fixture, evict_lru)
+{
+    constexpr size_t n = 10;
+    {
+        ResultCache cache(cache_dir, key, 0);
+        for (size_t i = 0; i < n; ++i) {
+            cache.store(i, result(i));
+        }
+    }
+    // entry i last used before entry i + 1
+    const auto now = fs::file_time_type::clock::now();
+    for (size_t i = 0; i < n; ++i) {
+        fs::last_write_time(entry_path(i), now - std::chrono::minutes(2 * n - i));
+    }
+    const uintmax_t total = cache_size();
+    const uintmax_t size = fs::file_size(entry_path(0));
+    ASSERT_EQ(total, n * size);
+
+    // nothing to do below max_size
+    EXPECT_EQ(ResultCache(cache_dir, key, total).evict(), static_cast<size_t>(0));
+
+    ResultCache cache(cache_dir, key, total - 1);
+    const uintmax_t target = (total - 1) * ResultCache::EVICT_TO;
+    size_t expected = 0;
+    while (total - expected * size > target) {
+        ++expected;
+    }
+    ASSERT_GT(expected, static_cast<size_t>(1));
+    EXPECT_EQ(cache.evict(), expected);
+    EXPECT_LE(cache_size(), target);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(static_cast<bool>(cache.load(i, "a")), i >= expected) << i;
+    }
+}
+
+// temporary files are removed once they are old enough to be left behind
+TEST_F(result_cache_fixture, evict_stale_tmp)
+{
+    ResultCache cache(cache_dir, key, 1 << 20);
+    cache.store(1, result(1));
+    const fs::path subdir = fs::path(entry_path(1)).parent_path();
+    const fs::path stale = subdir / (std::string(ResultCache::TMP_PREFIX) + "stale");
+    const fs::path fresh = subdir / (std::string(ResultCache::TMP_PREFIX) + "fresh");
+    write_file(stale.lexically_relative(dir).string(), "partial");
+    write_file(fresh.lexically_relative(dir).string(), "partial");
+    fs::last_write_time(stale, fs::file_time_type::clock::now() - ResultCache::TMP_MAX_AGE - std::chrono::minutes(1));
+
+    EXPECT_EQ(cache.evict(), static_cast<size_t>(0));
+    EXPECT_FALSE(fs::exists(stale));
+    EXPECT_TRUE(fs::exists(fresh));
+    EXPECT_TRUE(cache.load(1, "a"));
+}
+
+// entries and subdirectories removed while evicting (e.g. by concurrent runs) are skipped,
+// and every evict() still leaves no more than max_size of what is left
+TEST_F(result_cache_fixture, evict_concurrent)
+{
+    constexpr size_t n = 512;
+    for (size_t round = 0; round < 8; ++round) {
+        fs::remove_all(cache_dir);
+        ResultCache cache(cache_dir, key, 0);
+        for (size_t i = 0; i < n; ++i) {
+            cache.store(i * 0x0101010101010101 + round, result(i));
+        }
+        const uintmax_t max_size = cache_size() / 4;
+        ResultCache evicting(cache_dir, key, max_size);
+
+        std::vector<std::thread> threads;
+        // another run removes every other subdirectory
+        threads.emplace_back([this]() {
+            std::vector<fs::path> subdirs;
+            for (const auto& entry : fs::directory_iterator(cache_dir)) {
+                subdirs.push_back(entry.path());
+            }
+            std::error_code ec;
+            for (size_t i = 0; i < subdirs.size(); i += 2) {
+                fs::remove_all(subdirs[i], ec);
+            }
+        });
+        for (size_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&evicting]() { evicting.evict(); });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        EXPECT_LE(cache_size(), max_size) << round;
+    }
+}
+
+// results are taken from the cache by content, wherever the file is
+TEST_F(result_cache_fixture, parse_each)
+{
+    const std::vector<std::string> paths = {
+        write_file("a/f.hpp", "/// Function f.\nvoid f();\n"),
+        write_file("a/g.hpp", "int undocumented();\n"),
+        write_file("b/f.hpp", "/// Function f.\nvoid f();\n"),
+    };
+    const std::vector<uintmax_t> sizes(paths.size(), 1);
+    const core::lex::modal_lextable_t lextable = core::lex::make_modal_lextable();
+
+    ResultCache cache(cache_dir, key, 1 << 20);
+    std::vector<std::optional<uint64_t>> hashes(paths.size());
+    const std::vector<nlohmann::json> parsed = cache.parse_each(paths, sizes, hashes, lextable, 2);
+    EXPECT_EQ(parsed, parse_each(paths, sizes, lextable, 1));
+    EXPECT_EQ(hashes[0], hashes[2]);
+
+    std::vector<std::optional<uint64_t>> no_hashes(paths.size());
+    EXPECT_EQ(cache.parse_each(paths, sizes, no_hashes, lextable, 2), parsed);
+    EXPECT_EQ(no_hashes, hashes);
+    EXPECT_EQ(cache.hits(), paths.size());
+}
+
+} // namespace docgen
@@ -0,0 +1,176 @@
+#include <session.hpp>
+#include <io/file_hash.hpp>
+#include <io/temp_dir_fixture.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+namespace docgen {
+
+struct session_fixture : io::temp_dir_fixture
+{
+protected:
+    static constexpr std::string_view class_content =
+        "/// Some class.\n"
+        "template <class T>\n"
+        "struct S\n"
+        "{\n"
+        "    /// Some function.\n"
+        "    /// @param x some param\n"
+        "    void f(int x) { if (x) { return; } }\n"
+        "};\n";
+
+    static constexpr std::string_view func_content =
+        "/*! Some function.\n"
+        " * @return nothing\n"
+        " */\n"
+        "void g();\n";
+
+    // What lexing content at once (as a Session does, but without windows) parses.
+    static nlohmann::json whole_parse(std::string_view content, const char *name)
+    {
+        core::lex::ModalLexer lexer;
+        lexer.coalesce(true);
+        core::parse::Parser parser;
+        auto sink = [&](core::lex::ModalLexer::token_t&& token) {
+            parser.process(token);
+            if (parser.skip_block_requested()) {
+                lexer.skip_block();
+            }
+            lexer.want_text(parser.needs_text());
+        };
+        lexer.process(content, sink);
+        lexer.flush(sink);
+        nlohmann::json parsed = parser.parsed();
+        parsed[FILENAME_KEY] = name;
+        return parsed;
+    }
+
+    // What a fresh Session parses from content.
+    static nlohmann::json fresh_parse(std::string_view content, const char *name)
+    {
+        Session session;
+        nlohmann::json parsed;
+        session.parse_buffer(content, parsed, name);
+        return parsed;
+    }
+};
+
+// parsing the same inputs again with the same session gives the same result
+TEST_F(session_fixture, reuse)
+{
+    Session session;
+    nlohmann::json parsed;
+    session.parse_buffer(class_content, parsed, "a");
+    session.parse_buffer(func_content, parsed, "b");
+    session.parse_buffer(class_content, parsed, "a");
+
+    ASSERT_EQ(parsed.size(), static_cast<size_t>(3));
+    EXPECT_EQ(parsed[0], fresh_parse(class_content, "a")[0]);
+    EXPECT_EQ(parsed[1], fresh_parse(func_content, "b")[0]);
+    EXPECT_EQ(parsed[2], parsed[0]);
+    EXPECT_EQ(parsed[0][FILENAME_KEY], "a");
+    EXPECT_EQ(parsed[1][FILENAME_KEY], "b");
+}
+
+// an input cut off within a comment or a block leaves nothing behind for the next one
+TEST_F(session_fixture, reset_after_unterminated_input)
+{
+    static constexpr std::string_view cut_off[] = {
+        "/*! Unterminated doc block\n * @param x",
+        "/// Some class.\ntemplate <class T>\nstruct S\n{\n    void f() { if (true) {",
+        "/// Some function.\n/// @param x",
+        "/* plain comment\n",
+    };
+    for (std::string_view content : cut_off) {
+        Session session;
+        nlohmann::json parsed;
+        session.parse_buffer(content, parsed, "cut");
+        const size_t before = parsed.size();
+        session.parse_buffer(func_content, parsed, "b");
+        ASSERT_EQ(parsed.size(), before + 1) << content;
+        EXPECT_EQ(parsed.back(), fresh_parse(func_content, "b")[0]) << content;
+    }
+}
+
+// files are named by path and binary files are not parsed
+TEST_F(session_fixture, parse_file)
+{
+    const std::string text_path = write_file("a.hpp", class_content);
+    const std::string binary_path = write_file("b.bin", std::string_view("/// doc\0\0\0", 10));
+
+    Session session;
+    nlohmann::json parsed;
+    EXPECT_TRUE(session.parse_file(text_path.c_str(), parsed));
+    EXPECT_FALSE(session.parse_file(binary_path.c_str(), parsed));
+    ASSERT_EQ(parsed.size(), static_cast<size_t>(1));
+    EXPECT_EQ(parsed[0], fresh_parse(class_content, text_path.c_str())[0]);
+
+    session.sniff(false);
+    EXPECT_TRUE(session.parse_file(binary_path.c_str(), parsed));
+}
+
+// files without doc comments are parsed unless prefiltered,
+// as undocumented template classes are still parsed
+TEST_F(session_fixture, no_doc_comment)
+{
+    static constexpr std::string_view template_class =
+        "template <typename T>\n"
+        "class FooTest : public Base\n"
+        "{\n"
+        "};\n";
+    static constexpr std::string_view plain =
+        "// plain comment\n"
+        "int f() { return 0; }\n";
+
+    Session session;
+    nlohmann::json parsed;
+    session.parse_buffer(template_class, parsed, "a");
+    session.parse_buffer(plain, parsed, "b");
+    ASSERT_EQ(parsed.size(), static_cast<size_t>(1));
+    EXPECT_EQ(parsed[0], nlohmann::json::parse(
+        R"({"classes":[{"declaration":"class FooTest : public Base","tparamlists":["typename T"]}],"name":"a"})"));
+    EXPECT_EQ(session.skipped(), static_cast<size_t>(0));
+
+    session.prefilter(true);
+    session.parse_buffer(template_class, parsed, "a");
+    session.parse_buffer(plain, parsed, "b");
+    session.parse_buffer(func_content, parsed, "c");
+    ASSERT_EQ(parsed.size(), static_cast<size_t>(2));
+    EXPECT_EQ(parsed[1][FILENAME_KEY], "c");
+    EXPECT_EQ(session.skipped(), static_cast<size_t>(2));
+}
+
+// files over several input windows (mapped, and faulted in a window at a time)
+// are parsed as if lexed at once, whatever falls on window boundaries (even with prefilter)
+TEST_F(session_fixture, parse_file_windows)
+{
+    // doc comments (and a function body) across the boundaries of 1 MiB windows
+    std::string content;
+    for (size_t boundary : {size_t(1) << 20, size_t(2) << 20}) {
+        while (content.size() + 64 < boundary - 1) {
+            content += "int filler_" + std::to_string(content.size()) + ";\n";
+        }
+        content.append(boundary - 1 - content.size(), ' ');
+        content += class_content;
+        content += func_content;
+    }
+
+    // only doc comment opener across a boundary (see prefilter)
+    std::string single(content.begin(), content.begin() + (1 << 20) - 2);
+    single += "/// Some function.\nvoid f();\n";
+
+    for (const std::string& c : {content, single}) {
+        const std::string file_path = write_file("large.hpp", c);
+        Session session;
+        session.prefilter(true);
+        nlohmann::json parsed;
+        uint64_t hash = 0;
+        EXPECT_TRUE(session.parse_file(file_path.c_str(), parsed, &hash));
+        ASSERT_EQ(parsed.size(), static_cast<size_t>(1));
+        EXPECT_EQ(parsed[0], whole_parse(c, file_path.c_str()));
+        EXPECT_EQ(hash, io::hash_bytes(c));
+    }
+}
+
+} // namespace docgen